@@ -1,4 +1,4 @@
-QT       += core gui charts
+QT       += core gui charts concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -9,11 +9,49 @@ CONFIG += c++17
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    chartsummary.cpp \
+    csvparser.cpp \
+    downsampler.cpp \
+    eventjournal.cpp \
+    ganttchartview.cpp \
+    generatordialog.cpp \
+    latencyhistogram.cpp \
     main.cpp \
-    mainwindow.cpp
+    mainwindow.cpp \
+    phaseprofiler.cpp \
+    processindex.cpp \
+    processtablemodel.cpp \
+    profilerdock.cpp \
+    schedulerengine.cpp \
+    simulationworker.cpp \
+    sweepdialog.cpp \
+    sweeprunner.cpp \
+    tracewriter.cpp \
+    workloadgenerator.cpp \
+    workloadio.cpp
 
 HEADERS += \
-    mainwindow.h
+    chartsummary.h \
+    csvparser.h \
+    downsampler.h \
+    eventjournal.h \
+    ganttchartview.h \
+    generatordialog.h \
+    latencyhistogram.h \
+    mainwindow.h \
+    phaseprofiler.h \
+    processindex.h \
+    processtablemodel.h \
+    profilerdock.h \
+    readyqueue.h \
+    schedulerengine.h \
+    simulationworker.h \
+    stringutil.h \
+    sweepdialog.h \
+    sweeprunner.h \
+    tracewriter.h \
+    workloadgenerator.h \
+    workloadio.h
 
 FORMS += \
     mainwindow.ui
@@ -0,0 +1,37 @@
+QT       += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = SimulatorBench
+
+SOURCES += \
+    chartsummary.cpp \
+    csvparser.cpp \
+    eventjournal.cpp \
+    ganttchartview.cpp \
+    latencyhistogram.cpp \
+    processindex.cpp \
+    processtablemodel.cpp \
+    schedulerengine.cpp \
+    simulatorbench.cpp \
+    tracewriter.cpp \
+    workloadgenerator.cpp \
+    workloadio.cpp
+
+HEADERS += \
+    chartsummary.h \
+    csvparser.h \
+    eventjournal.h \
+    ganttchartview.h \
+    latencyhistogram.h \
+    processindex.h \
+    processtablemodel.h \
+    readyqueue.h \
+    schedulerengine.h \
+    stringutil.h \
+    tracewriter.h \
+    workloadgenerator.h \
+    workloadio.h
@@ -0,0 +1,23 @@
+CONFIG += c++17 console
+CONFIG -= app_bundle qt
+
+TARGET = SimulatorTests
+
+SOURCES += \
+    csvparser.cpp \
+    eventjournal.cpp \
+    latencyhistogram.cpp \
+    schedulerengine.cpp \
+    simulatortests.cpp \
+    sweeprunner.cpp \
+    tracewriter.cpp
+
+HEADERS += \
+    csvparser.h \
+    eventjournal.h \
+    latencyhistogram.h \
+    readyqueue.h \
+    schedulerengine.h \
+    stringutil.h \
+    sweeprunner.h \
+    tracewriter.h
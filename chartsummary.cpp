@@ -0,0 +1,118 @@
+#include "chartsummary.h"
+
+#include <algorithm>
+
+namespace {
+
+// The topCount largest values seen so far, as a min-heap on (value, -index)
+class TopProcesses
+{
+public:
+    explicit TopProcesses(int count)
+        : capacity(static_cast<std::size_t>(std::max(count, 0)))
+    {
+        heap.reserve(capacity);
+    }
+
+    void offer(SimTime value, int index)
+    {
+        // Indices come in increasing order, so an equal value never displaces an earlier process
+        if (heap.size() < capacity) {
+            heap.push_back({value, index});
+            std::push_heap(heap.begin(), heap.end(), Greater());
+        } else if (capacity > 0 && value > heap.front().value) {
+            std::pop_heap(heap.begin(), heap.end(), Greater());
+            heap.back() = {value, index};
+            std::push_heap(heap.begin(), heap.end(), Greater());
+        }
+    }
+
+    std::vector<int> takeIndices()
+    {
+        std::sort(heap.begin(), heap.end(), Greater());
+        std::vector<int> indices;
+        indices.reserve(heap.size());
+        for (const Entry &entry : heap) {
+            indices.push_back(entry.index);
+        }
+        return indices;
+    }
+
+private:
+    struct Entry
+    {
+        SimTime value;
+        int index;
+    };
+
+    // Larger values first, then earlier indices
+    struct Greater
+    {
+        bool operator()(const Entry &a, const Entry &b) const
+        {
+            return a.value != b.value ? a.value > b.value : a.index < b.index;
+        }
+    };
+
+    std::size_t capacity;
+    std::vector<Entry> heap;
+};
+
+void startHistogram(MetricHistogram &histogram, std::int64_t maximum, int binCount)
+{
+    binCount = std::max(binCount, 1);
+    histogram.binShift = 0;
+    while ((maximum >> histogram.binShift) >= binCount) {
+        ++histogram.binShift;
+    }
+    histogram.binWidth = SimTime(1) << histogram.binShift;
+    histogram.counts.assign(static_cast<std::size_t>((maximum >> histogram.binShift) + 1), 0);
+}
+
+void addToHistogram(MetricHistogram &histogram, SimTime value)
+{
+    ++histogram.counts[static_cast<std::size_t>(std::max<SimTime>(value, 0) >> histogram.binShift)];
+}
+
+} // namespace
+
+ProcessChartSummary summarizeProcesses(const SchedulerEngine &engine, int maxProcesses, int binCount, int topCount)
+{
+    const ProcessStore &store = engine.processes();
+    ProcessChartSummary summary;
+    summary.aggregated = engine.completedCount() > maxProcesses;
+
+    TopProcesses longestWaits(summary.aggregated ? topCount : 0);
+    TopProcesses longestBursts(summary.aggregated ? topCount : 0);
+    if (summary.aggregated) {
+        startHistogram(summary.waiting, engine.waitingHistogram().max(), binCount);
+        startHistogram(summary.turnaround, engine.turnaroundHistogram().max(), binCount);
+        startHistogram(summary.response, engine.responseHistogram().max(), binCount);
+    } else {
+        summary.processes.reserve(engine.completedCount());
+    }
+
+    for (int i = 0; i < store.size(); ++i) {
+        if (store.status[i] != ProcessStatus::Completed) {
+            continue;
+        }
+        ++summary.completed;
+        summary.totalBurst += store.burstTime[i];
+        if (!summary.aggregated) {
+            summary.processes.push_back(i);
+            continue;
+        }
+        const SimTime waiting = store.waitingTime(i);
+        addToHistogram(summary.waiting, waiting);
+        addToHistogram(summary.turnaround, store.turnaroundTime(i));
+        addToHistogram(summary.response, store.responseTime(i));
+        longestWaits.offer(waiting, i);
+        longestBursts.offer(store.burstTime[i], i);
+    }
+
+    if (summary.aggregated) {
+        summary.processes = longestWaits.takeIndices();
+        summary.longestBursts = longestBursts.takeIndices();
+    }
+    return summary;
+}
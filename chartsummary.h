@@ -0,0 +1,46 @@
+#ifndef CHARTSUMMARY_H
+#define CHARTSUMMARY_H
+
+#include <cstdint>
+#include <vector>
+
+#include "schedulerengine.h"
+
+// Equal-width bins over [0, binWidth * counts.size()); bin k counts the values
+// in [k * binWidth, (k + 1) * binWidth). The width is a power of two, so
+// binning a value is a shift rather than a division.
+struct MetricHistogram
+{
+    SimTime binWidth = 1;
+    int binShift = 0;
+    std::vector<std::int64_t> counts;
+};
+
+// What the per-process performance charts show. While at most maxProcesses
+// processes have completed, each of them gets a bar and a slice of its own.
+// Beyond that, drawing one bar per process is both slow and unreadable, so
+// the summary is aggregated instead. Waiting, turnaround and response times
+// become histograms. The comparison chart shows the topCount processes with
+// the longest waiting times, and the CPU share chart shows those with the
+// longest bursts; the rest are summed up as "other" by the caller.
+struct ProcessChartSummary
+{
+    bool aggregated = false;
+    int completed = 0;
+    SimTime totalBurst = 0;
+    // Completed processes in store order, or when aggregated the longest
+    // waiting ones, longest first (ties in store order)
+    std::vector<int> processes;
+    // Aggregated only: the longest bursts, longest first
+    std::vector<int> longestBursts;
+    MetricHistogram waiting;
+    MetricHistogram turnaround;
+    MetricHistogram response;
+};
+
+// One pass over the processes. The histograms get between binCount / 2 and
+// binCount bins up to the maximum of each metric, which the engine already
+// tracks.
+ProcessChartSummary summarizeProcesses(const SchedulerEngine &engine, int maxProcesses, int binCount, int topCount);
+
+#endif // CHARTSUMMARY_H
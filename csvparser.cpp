@@ -0,0 +1,256 @@
+#include "csvparser.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+const std::size_t ParallelThreshold = 4 << 20;
+const std::size_t ProgressGranularity = 1 << 20;
+const char *const FieldNames[4] = { "ID", "ArrivalTime", "BurstTime", "Priority" };
+
+// One contiguous run of whole lines, parsed independently of the others
+struct Chunk
+{
+    const char *begin = nullptr;
+    const char *end = nullptr;
+    bool firstInFile = false;
+    std::vector<int> id;
+    std::vector<SimTime> arrivalTime;
+    std::vector<int> burstTime;
+    std::vector<int> priority;
+    std::int64_t lines = 0;
+    std::int64_t errorCount = 0;
+    std::vector<CsvParseError> errors;
+    bool cancelled = false;
+};
+
+inline bool isBlank(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+// Parses an optionally signed decimal integer surrounded by blanks
+bool parseInteger(const char *&p, const char *end, std::int64_t &value)
+{
+    while (p < end && isBlank(*p)) {
+        ++p;
+    }
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    const char *digits = p;
+    std::int64_t magnitude = 0;
+    while (p < end && isDigit(*p)) {
+        // 18 digits always fit in 64 bits, and nothing sensible needs more
+        if (p - digits == 18) {
+            return false;
+        }
+        magnitude = magnitude * 10 + (*p - '0');
+        ++p;
+    }
+    if (p == digits) {
+        return false;
+    }
+
+    while (p < end && isBlank(*p)) {
+        ++p;
+    }
+    value = negative ? -magnitude : magnitude;
+    return true;
+}
+
+void reportError(Chunk &chunk, std::int64_t line, std::string message)
+{
+    ++chunk.errorCount;
+    if (chunk.errors.size() < static_cast<std::size_t>(MaxReportedErrors)) {
+        chunk.errors.push_back({line, std::move(message)});
+    }
+}
+
+void parseRow(const char *begin, const char *end, std::int64_t line, Chunk &chunk)
+{
+    std::int64_t fields[4];
+    const char *p = begin;
+
+    for (int f = 0; f < 4; ++f) {
+        const bool parsed = parseInteger(p, end, fields[f]);
+        const bool terminated = p == end ? f == 3 : *p == ',';
+        if (!parsed || !terminated) {
+            const int fieldCount = 1 + static_cast<int>(std::count(begin, end, ','));
+            if (fieldCount < 4) {
+                reportError(chunk, line, "expected 4 fields, found " + std::to_string(fieldCount));
+            } else {
+                reportError(chunk, line, std::string("field ") + FieldNames[f] + " is not a valid integer");
+            }
+            return;
+        }
+        if (p != end) {
+            ++p;
+        }
+    }
+
+    for (int f : { 0, 2, 3 }) {
+        if (fields[f] < INT_MIN || fields[f] > INT_MAX) {
+            reportError(chunk, line, std::string("field ") + FieldNames[f] + " is out of range");
+            return;
+        }
+    }
+    if (!ProcessStore::isValidBurstTime(fields[2])) {
+        reportError(chunk, line, std::string("field ") + FieldNames[2] + " must be positive");
+        return;
+    }
+
+    chunk.id.push_back(static_cast<int>(fields[0]));
+    chunk.arrivalTime.push_back(fields[1]);
+    chunk.burstTime.push_back(static_cast<int>(fields[2]));
+    chunk.priority.push_back(static_cast<int>(fields[3]));
+}
+
+void parseChunk(Chunk &chunk, CsvParseProgress *progress)
+{
+    // Rough guess of ten bytes per row avoids most reallocations
+    const std::size_t estimatedRows = static_cast<std::size_t>(chunk.end - chunk.begin) / 10;
+    chunk.id.reserve(estimatedRows);
+    chunk.arrivalTime.reserve(estimatedRows);
+    chunk.burstTime.reserve(estimatedRows);
+    chunk.priority.reserve(estimatedRows);
+
+    const char *p = chunk.begin;
+    const char *lastReport = p;
+    std::int64_t line = 0;
+
+    if (chunk.firstInFile && chunk.end - p >= 3 && std::memcmp(p, "\xEF\xBB\xBF", 3) == 0) {
+        p += 3;
+    }
+
+    while (p < chunk.end) {
+        const char *newline = static_cast<const char *>(std::memchr(p, '\n', chunk.end - p));
+        const char *lineEnd = newline ? newline : chunk.end;
+        const char *contentEnd = lineEnd;
+        if (contentEnd > p && contentEnd[-1] == '\r') {
+            --contentEnd;
+        }
+        ++line;
+
+        const char *first = p;
+        while (first < contentEnd && isBlank(*first)) {
+            ++first;
+        }
+
+        if (first == contentEnd) {
+            // Blank line
+        } else if (chunk.firstInFile && line == 1 && !isDigit(*first) && *first != '-' && *first != '+') {
+            // Header line
+        } else {
+            parseRow(p, contentEnd, line, chunk);
+        }
+
+        p = newline ? newline + 1 : chunk.end;
+
+        if (progress && static_cast<std::size_t>(p - lastReport) >= ProgressGranularity) {
+            progress->bytesParsed += static_cast<std::size_t>(p - lastReport);
+            lastReport = p;
+            if (progress->cancelRequested) {
+                chunk.cancelled = true;
+                return;
+            }
+        }
+    }
+
+    if (progress) {
+        progress->bytesParsed += static_cast<std::size_t>(p - lastReport);
+    }
+    chunk.lines = line;
+}
+
+} // namespace
+
+CsvParseResult parseWorkloadCsv(const char *data, std::size_t size, ProcessStore &store,
+                                CsvParseProgress *progress, int threadCount)
+{
+    CsvParseResult result;
+
+    int chunkCount = threadCount > 0 ? threadCount : static_cast<int>(std::thread::hardware_concurrency());
+    if (chunkCount < 1 || size < ParallelThreshold) {
+        chunkCount = 1;
+    }
+
+    // Split at line boundaries so every chunk holds whole rows
+    std::vector<Chunk> chunks(chunkCount);
+    const char *end = data + size;
+    const char *begin = data;
+    for (int i = 0; i < chunkCount; ++i) {
+        const char *chunkEnd = end;
+        if (i + 1 < chunkCount) {
+            chunkEnd = std::max(begin, data + size / chunkCount * (i + 1));
+            const char *newline = static_cast<const char *>(std::memchr(chunkEnd, '\n', end - chunkEnd));
+            chunkEnd = newline ? newline + 1 : end;
+        }
+        chunks[i].begin = begin;
+        chunks[i].end = chunkEnd;
+        chunks[i].firstInFile = i == 0;
+        begin = chunkEnd;
+    }
+
+    if (chunkCount == 1) {
+        parseChunk(chunks[0], progress);
+    } else {
+        std::vector<std::thread> workers;
+        workers.reserve(chunkCount - 1);
+        for (int i = 1; i < chunkCount; ++i) {
+            workers.emplace_back(parseChunk, std::ref(chunks[i]), progress);
+        }
+        parseChunk(chunks[0], progress);
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+    }
+
+    std::size_t rowCount = 0;
+    for (const Chunk &chunk : chunks) {
+        result.cancelled = result.cancelled || chunk.cancelled;
+        rowCount += chunk.id.size();
+    }
+    if (result.cancelled || (progress && progress->cancelRequested)) {
+        result.cancelled = true;
+        return result;
+    }
+
+    // Stitch the chunks together; line numbers continue from the previous chunk
+    store.clear();
+    store.reserve(static_cast<int>(rowCount));
+    std::int64_t lineOffset = 0;
+    for (const Chunk &chunk : chunks) {
+        store.id.insert(store.id.end(), chunk.id.begin(), chunk.id.end());
+        store.arrivalTime.insert(store.arrivalTime.end(), chunk.arrivalTime.begin(), chunk.arrivalTime.end());
+        store.burstTime.insert(store.burstTime.end(), chunk.burstTime.begin(), chunk.burstTime.end());
+        store.priority.insert(store.priority.end(), chunk.priority.begin(), chunk.priority.end());
+
+        result.errorCount += chunk.errorCount;
+        for (const CsvParseError &error : chunk.errors) {
+            if (result.errors.size() < static_cast<std::size_t>(MaxReportedErrors)) {
+                result.errors.push_back({lineOffset + error.line, error.message});
+            }
+        }
+        lineOffset += chunk.lines;
+    }
+    store.startTime.resize(rowCount);
+    store.completionTime.resize(rowCount);
+    store.status.resize(rowCount);
+    store.resetResults();
+
+    result.rowCount = static_cast<std::int64_t>(rowCount);
+    return result;
+}
@@ -0,0 +1,47 @@
+#ifndef CSVPARSER_H
+#define CSVPARSER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "schedulerengine.h"
+
+struct CsvParseError
+{
+    std::int64_t line;
+    std::string message;
+};
+
+// Shared with the thread that started the parse: bytesParsed can be polled
+// for progress, and setting cancelRequested stops every worker promptly.
+struct CsvParseProgress
+{
+    std::atomic<std::size_t> bytesParsed{0};
+    std::atomic<bool> cancelRequested{false};
+};
+
+struct CsvParseResult
+{
+    bool cancelled = false;
+    std::int64_t rowCount = 0;
+    std::int64_t errorCount = 0;
+    std::vector<CsvParseError> errors;  // the first MaxReportedErrors, ordered by line
+};
+
+const int MaxReportedErrors = 100;
+
+// Parses "ID,ArrivalTime,BurstTime,Priority" rows from an in-memory (typically
+// memory-mapped) buffer straight into store. An optional header line is
+// skipped, blank lines are ignored and extra columns are allowed. Rows that
+// are not four integers, or whose burst time is not positive, are reported
+// with their 1-based line number.
+// Large buffers are split at line boundaries and parsed on threadCount worker
+// threads (0 picks the hardware concurrency); the store is only filled in when
+// the parse was not cancelled.
+CsvParseResult parseWorkloadCsv(const char *data, std::size_t size, ProcessStore &store,
+                                CsvParseProgress *progress = nullptr, int threadCount = 0);
+
+#endif // CSVPARSER_H
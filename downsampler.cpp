@@ -0,0 +1,60 @@
+#include "downsampler.h"
+
+#include <cmath>
+
+std::vector<SeriesPoint> downsampleLttb(const std::vector<SeriesPoint> &points, std::size_t maxPoints)
+{
+    if (maxPoints < 3 || points.size() <= maxPoints) {
+        return points;
+    }
+
+    std::vector<SeriesPoint> result;
+    result.reserve(maxPoints);
+    result.push_back(points.front());
+
+    // Buckets of the points between the first and the last; bucket i is [bucketStart(i), bucketStart(i + 1))
+    const std::size_t bucketCount = maxPoints - 2;
+    const double bucketSize = static_cast<double>(points.size() - 2) / bucketCount;
+    auto bucketStart = [&](std::size_t bucket) {
+        return bucket >= bucketCount ? points.size() - 1 : static_cast<std::size_t>(bucket * bucketSize) + 1;
+    };
+
+    std::size_t kept = 0;
+    for (std::size_t bucket = 0; bucket < bucketCount; ++bucket) {
+        const std::size_t begin = bucketStart(bucket);
+        const std::size_t end = bucketStart(bucket + 1);
+
+        // Mean of the next bucket, or the last point after the final bucket
+        double nextX = points.back().x;
+        double nextY = points.back().y;
+        if (bucket + 1 < bucketCount) {
+            const std::size_t nextEnd = bucketStart(bucket + 2);
+            nextX = 0.0;
+            nextY = 0.0;
+            for (std::size_t i = end; i < nextEnd; ++i) {
+                nextX += points[i].x;
+                nextY += points[i].y;
+            }
+            nextX /= nextEnd - end;
+            nextY /= nextEnd - end;
+        }
+
+        const SeriesPoint &previous = points[kept];
+        std::size_t best = begin;
+        double bestArea = -1.0;
+        for (std::size_t i = begin; i < end; ++i) {
+            // Twice the triangle's area; the factor does not change the choice
+            const double area = std::abs((previous.x - nextX) * (points[i].y - previous.y)
+                                         - (previous.x - points[i].x) * (nextY - previous.y));
+            if (area > bestArea) {
+                bestArea = area;
+                best = i;
+            }
+        }
+        result.push_back(points[best]);
+        kept = best;
+    }
+
+    result.push_back(points.back());
+    return result;
+}
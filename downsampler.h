@@ -0,0 +1,22 @@
+#ifndef DOWNSAMPLER_H
+#define DOWNSAMPLER_H
+
+#include <cstddef>
+#include <vector>
+
+struct SeriesPoint
+{
+    double x;
+    double y;
+};
+
+// Largest-Triangle-Three-Buckets downsampling (Steinarsson, 2013). Keeps the
+// first and last point and splits the rest into maxPoints - 2 buckets of
+// consecutive points; from each bucket it keeps the point that spans the
+// largest triangle with the point kept before it and the mean of the next
+// bucket. Peaks and dips therefore survive, unlike with averaging or taking
+// every n-th point. points must be sorted by x. Series of at most maxPoints
+// points (or maxPoints below 3) are returned unchanged. O(n).
+std::vector<SeriesPoint> downsampleLttb(const std::vector<SeriesPoint> &points, std::size_t maxPoints);
+
+#endif // DOWNSAMPLER_H
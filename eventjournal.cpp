@@ -0,0 +1,352 @@
+#include "eventjournal.h"
+#include "stringutil.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace {
+
+const char JournalMagic[8] = { 'S', 'C', 'H', 'E', 'D', 'L', 'O', 'G' };
+const std::uint32_t JournalVersion = 1;
+const std::size_t HeaderSize = 24;
+const std::size_t BufferCapacity = 1 << 20;
+// Type byte, then at most ten bytes for each of the core, time and process varints
+const std::size_t MaxRecordLength = 31;
+const int InlineCoreLimit = 63;
+const std::size_t ReplayBatchSize = 4096;
+
+unsigned char *putVarint(unsigned char *out, std::uint64_t value)
+{
+    while (value >= 0x80) {
+        *out++ = static_cast<unsigned char>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<unsigned char>(value);
+    return out;
+}
+
+// Null when the varint runs past end or over 64 bits
+inline const unsigned char *getVarint(const unsigned char *in, const unsigned char *end, std::uint64_t &value)
+{
+    // Most values fit in one byte
+    if (in != end && *in < 0x80) {
+        value = *in;
+        return in + 1;
+    }
+    value = 0;
+    for (int shift = 0; shift < 64 && in != end; shift += 7) {
+        const unsigned char byte = *in++;
+        value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if (byte < 0x80) {
+            return in;
+        }
+    }
+    return nullptr;
+}
+
+std::uint64_t zigzag(std::int64_t value)
+{
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value)
+{
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+void putUint(unsigned char *out, std::uint64_t value, int size)
+{
+    for (int i = 0; i < size; ++i) {
+        out[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+std::uint64_t getUint(const unsigned char *in, int size)
+{
+    std::uint64_t value = 0;
+    for (int i = 0; i < size; ++i) {
+        value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+} // namespace
+
+EventJournal::EventJournal()
+    : file(nullptr)
+    , used(0)
+    , failed(false)
+    , events(0)
+    , bytes(0)
+    , lastTime(0)
+    , lastProcess{0, 0, 0, 0}
+{
+}
+
+EventJournal::~EventJournal()
+{
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+bool EventJournal::open(const std::string &fileName, int coreCount, int processCount, std::string *errorMessage)
+{
+    if (file) {
+        std::fclose(file);
+    }
+    file = std::fopen(fileName.c_str(), "wb");
+    if (!file) {
+        setError(errorMessage, "Could not open file for writing.");
+        return false;
+    }
+    buffer.resize(BufferCapacity);
+    failed = false;
+    events = 0;
+    lastTime = 0;
+    std::fill(std::begin(lastProcess), std::end(lastProcess), 0);
+
+    std::memcpy(buffer.data(), JournalMagic, sizeof(JournalMagic));
+    putUint(buffer.data() + 8, JournalVersion, 4);
+    putUint(buffer.data() + 12, static_cast<std::uint32_t>(coreCount), 4);
+    putUint(buffer.data() + 16, static_cast<std::uint64_t>(processCount), 8);
+    used = HeaderSize;
+    bytes = HeaderSize;
+    return true;
+}
+
+bool EventJournal::close(std::string *errorMessage)
+{
+    if (!file) {
+        return true;
+    }
+    flush();
+    const bool closed = std::fclose(file) == 0 && !failed;
+    file = nullptr;
+    buffer.clear();
+    buffer.shrink_to_fit();
+    if (!closed) {
+        setError(errorMessage, "Could not write the journal file.");
+    }
+    return closed;
+}
+
+void EventJournal::record(JournalEventType type, SimTime time, int core, int process)
+{
+    if (used + MaxRecordLength > buffer.size()) {
+        flush();
+    }
+    unsigned char *const start = buffer.data() + used;
+    unsigned char *out = start;
+    const int typeIndex = static_cast<int>(type);
+    *out++ = static_cast<unsigned char>(typeIndex | std::min(core, InlineCoreLimit) << 2);
+    if (core >= InlineCoreLimit) {
+        out = putVarint(out, static_cast<std::uint64_t>(core - InlineCoreLimit));
+    }
+    out = putVarint(out, static_cast<std::uint64_t>(time - lastTime));
+    out = putVarint(out, zigzag(static_cast<std::int64_t>(process) - lastProcess[typeIndex]));
+    lastTime = time;
+    lastProcess[typeIndex] = process;
+    used += out - start;
+    bytes += out - start;
+    ++events;
+}
+
+void EventJournal::flush()
+{
+    if (used > 0 && !failed) {
+        failed = std::fwrite(buffer.data(), 1, used, file) != used;
+    }
+    used = 0;
+}
+
+JournalReader::JournalReader()
+    : file(nullptr)
+    , position(0)
+    , filled(0)
+    , atEnd(true)
+    , corrupt(false)
+    , cores(0)
+    , processes(0)
+    , lastTime(0)
+    , lastProcess{0, 0, 0, 0}
+{
+}
+
+JournalReader::~JournalReader()
+{
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+bool JournalReader::open(const std::string &fileName, std::string *errorMessage)
+{
+    if (file) {
+        std::fclose(file);
+    }
+    file = std::fopen(fileName.c_str(), "rb");
+    if (!file) {
+        setError(errorMessage, "Could not open file for reading.");
+        return false;
+    }
+    unsigned char header[HeaderSize];
+    if (std::fread(header, 1, HeaderSize, file) != HeaderSize || std::memcmp(header, JournalMagic, sizeof(JournalMagic)) != 0) {
+        setError(errorMessage, "Not an event journal.");
+        return false;
+    }
+    if (getUint(header + 8, 4) != JournalVersion) {
+        setError(errorMessage, "Unsupported journal version.");
+        return false;
+    }
+    cores = static_cast<int>(getUint(header + 12, 4));
+    processes = static_cast<std::int64_t>(getUint(header + 16, 8));
+
+    buffer.resize(BufferCapacity);
+    position = 0;
+    filled = 0;
+    atEnd = false;
+    corrupt = false;
+    lastTime = 0;
+    std::fill(std::begin(lastProcess), std::end(lastProcess), 0);
+    return true;
+}
+
+bool JournalReader::next(JournalEvent &event)
+{
+    return read(&event, 1) == 1;
+}
+
+std::size_t JournalReader::read(JournalEvent *events, std::size_t capacity)
+{
+    // Top up the buffer while a whole record might not be in it
+    if (filled - position < MaxRecordLength && !atEnd) {
+        refill();
+    }
+
+    // Decoding works on locals, so the loop stays in registers
+    const unsigned char *in = buffer.data() + position;
+    const unsigned char *const end = buffer.data() + filled;
+    const unsigned char *const safeEnd = atEnd ? end : end - MaxRecordLength;
+    SimTime time = lastTime;
+    std::size_t count = 0;
+    while (count < capacity && in < end && (in <= safeEnd || atEnd)) {
+        const int typeIndex = *in & 3;
+        int core = *in++ >> 2;
+        std::uint64_t value = 0;
+        if (core == InlineCoreLimit) {
+            in = getVarint(in, end, value);
+            core += static_cast<int>(value);
+        }
+        std::uint64_t delta = 0;
+        if (in) {
+            in = getVarint(in, end, delta);
+        }
+        if (in) {
+            in = getVarint(in, end, value);
+        }
+        if (!in) {
+            corrupt = true;
+            in = end;
+            break;
+        }
+        time += static_cast<SimTime>(delta);
+        lastProcess[typeIndex] += static_cast<int>(unzigzag(value));
+        JournalEvent &event = events[count++];
+        event.type = static_cast<JournalEventType>(typeIndex);
+        event.core = core;
+        event.process = lastProcess[typeIndex];
+        event.time = time;
+    }
+    lastTime = time;
+    position = in - buffer.data();
+    return count;
+}
+
+void JournalReader::refill()
+{
+    const std::size_t remaining = filled - position;
+    std::memmove(buffer.data(), buffer.data() + position, remaining);
+    position = 0;
+    filled = remaining + std::fread(buffer.data() + remaining, 1, buffer.size() - remaining, file);
+    atEnd = filled < buffer.size();
+}
+
+bool replayJournal(const std::string &fileName, ProcessStore &store, SimTime until,
+                   std::vector<std::vector<ExecutionSegment>> *segments,
+                   JournalReplay *result, std::string *errorMessage)
+{
+    JournalReader reader;
+    if (!reader.open(fileName, errorMessage)) {
+        return false;
+    }
+    if (reader.processCount() != store.size()) {
+        setError(errorMessage, "The journal was recorded from a different workload.");
+        return false;
+    }
+
+    store.resetResults();
+    if (segments) {
+        segments->assign(std::max(reader.coreCount(), 1), std::vector<ExecutionSegment>());
+    }
+    JournalReplay replay;
+    std::vector<JournalEvent> batch(ReplayBatchSize);
+    std::size_t count = 0;
+    std::size_t next = 0;
+    for (;;) {
+        if (next == count) {
+            count = reader.read(batch.data(), batch.size());
+            next = 0;
+            if (count == 0) {
+                break;
+            }
+        }
+        const JournalEvent &event = batch[next++];
+        if (event.time > until) {
+            break;
+        }
+        if (event.process < 0 || event.process >= store.size() || event.core < 0 || event.core >= reader.coreCount()) {
+            setError(errorMessage, "The journal is damaged.");
+            return false;
+        }
+        const int index = event.process;
+        switch (event.type) {
+        case JournalEventType::Dispatch:
+            store.status[index] = ProcessStatus::Running;
+            if (store.startTime[index] == -1) {
+                store.startTime[index] = event.time;
+            }
+            if (segments) {
+                (*segments)[event.core].push_back({index, event.time, -1});
+            }
+            break;
+        case JournalEventType::Preempt:
+            store.status[index] = ProcessStatus::Waiting;
+            if (segments && !(*segments)[event.core].empty()) {
+                (*segments)[event.core].back().end = event.time - 1;
+            }
+            break;
+        case JournalEventType::Complete:
+            store.status[index] = ProcessStatus::Completed;
+            store.completionTime[index] = event.time;
+            if (segments && !(*segments)[event.core].empty()) {
+                (*segments)[event.core].back().end = event.time;
+            }
+            break;
+        default:
+            // Arrived processes wait, as they did before
+            break;
+        }
+        replay.time = event.time;
+        ++replay.events;
+    }
+    if (reader.isCorrupt()) {
+        setError(errorMessage, "The journal is damaged.");
+        return false;
+    }
+    if (result) {
+        *result = replay;
+    }
+    return true;
+}
@@ -0,0 +1,127 @@
+#ifndef EVENTJOURNAL_H
+#define EVENTJOURNAL_H
+
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "schedulerengine.h"
+
+enum class JournalEventType : std::uint8_t {
+    Arrival,
+    Dispatch,
+    Preempt,
+    Complete
+};
+
+// An arrival joins core's ready queue at time; a dispatch starts running the
+// process at time, a preemption takes it off the CPU at time (it ran up to
+// time - 1) and a completion ends it after tick time.
+struct JournalEvent
+{
+    JournalEventType type;
+    int core;
+    int process;
+    SimTime time;
+};
+
+// Append-only record of a run's arrivals, dispatches, preemptions and
+// completions, written while the engine simulates (little-endian, extension
+// .simlog):
+//
+//   header  char magic[8] = "SCHEDLOG", uint32 version, uint32 coreCount, uint64 processCount
+//   events  one record each, in the order they happened
+//
+// A record starts with a byte holding the event type in its low two bits and
+// the core above them (63 means the core is 63 plus a varint that follows),
+// then the time since the previous event as a varint and the process index
+// as a zigzag varint of its difference from the previous event of the same
+// type. Times never go backwards and most differences are small, so a record
+// is typically three bytes. Events go out through a fixed-size buffer, so
+// memory use does not grow with the length of the run.
+class EventJournal
+{
+public:
+    EventJournal();
+    ~EventJournal();
+
+    EventJournal(const EventJournal &) = delete;
+    EventJournal &operator=(const EventJournal &) = delete;
+
+    bool open(const std::string &fileName, int coreCount, int processCount, std::string *errorMessage = nullptr);
+    bool close(std::string *errorMessage = nullptr);
+    bool isOpen() const { return file != nullptr; }
+    std::int64_t eventCount() const { return events; }
+    std::int64_t byteCount() const { return bytes; }
+
+    // Called by the engine
+    void record(JournalEventType type, SimTime time, int core, int process);
+
+private:
+    std::FILE *file;
+    std::vector<unsigned char> buffer;
+    std::size_t used;
+    bool failed;
+    std::int64_t events;
+    std::int64_t bytes;
+    SimTime lastTime;
+    int lastProcess[4];
+
+    void flush();
+};
+
+// Decodes a journal one event at a time, reading it in large blocks
+class JournalReader
+{
+public:
+    JournalReader();
+    ~JournalReader();
+
+    JournalReader(const JournalReader &) = delete;
+    JournalReader &operator=(const JournalReader &) = delete;
+
+    bool open(const std::string &fileName, std::string *errorMessage = nullptr);
+    int coreCount() const { return cores; }
+    std::int64_t processCount() const { return processes; }
+
+    // False at the end of the journal, or at a damaged record (see isCorrupt())
+    bool next(JournalEvent &event);
+    // Decodes up to capacity events into events; 0 at the end or a damaged record
+    std::size_t read(JournalEvent *events, std::size_t capacity);
+    bool isCorrupt() const { return corrupt; }
+
+private:
+    std::FILE *file;
+    std::vector<unsigned char> buffer;
+    std::size_t position;
+    std::size_t filled;
+    bool atEnd;
+    bool corrupt;
+    int cores;
+    std::int64_t processes;
+    SimTime lastTime;
+    int lastProcess[4];
+
+    void refill();
+};
+
+struct JournalReplay
+{
+    // Time of the last event replayed
+    SimTime time = 0;
+    std::int64_t events = 0;
+};
+
+// Rebuilds the results of a run from its journal without simulating: store
+// must hold the workload the journal was recorded from, and gets the
+// statuses, start and completion times the engine had after advanceTo(until)
+// (or run(), by default). With segments given, it also gets every core's
+// execution segments as the engine records them.
+bool replayJournal(const std::string &fileName, ProcessStore &store,
+                   SimTime until = std::numeric_limits<SimTime>::max(),
+                   std::vector<std::vector<ExecutionSegment>> *segments = nullptr,
+                   JournalReplay *result = nullptr, std::string *errorMessage = nullptr);
+
+#endif // EVENTJOURNAL_H
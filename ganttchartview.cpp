@@ -0,0 +1,378 @@
+#include "ganttchartview.h"
+
+#include <QHelpEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QScrollBar>
+#include <QToolTip>
+#include <QWheelEvent>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace {
+const int LabelWidth = 60;
+const int TopMargin = 10;
+const int LaneHeight = 30;
+const int AxisGap = 10;
+const int AxisHeight = 35;
+const int MinTickSpacing = 70;
+const double MinPixelsPerUnit = 1e-7;
+const double MaxPixelsPerUnit = 200.0;
+}
+
+GanttChartView::GanttChartView(QWidget *parent)
+    : QAbstractScrollArea(parent)
+    , engine(nullptr)
+    , pixelsPerUnit(20.0)
+    , viewStart(0.0)
+    , updatingScrollBar(false)
+    , dragging(false)
+    , dragViewStart(0.0)
+{
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    viewport()->setMouseTracking(true);
+}
+
+void GanttChartView::setEngine(const SchedulerEngine *engine)
+{
+    this->engine = engine;
+    viewStart = 0.0;
+    verticalScrollBar()->setValue(0);
+    refresh();
+}
+
+QColor GanttChartView::processColor(int processId)
+{
+    // Derived from the id so no per-process colour has to be stored
+    const quint32 hash = static_cast<quint32>(processId) * 2654435761u;
+    return QColor(
+        50 + (hash & 0xFF) % 150,
+        50 + ((hash >> 8) & 0xFF) % 150,
+        50 + ((hash >> 16) & 0xFF) % 150
+    );
+}
+
+void GanttChartView::refresh()
+{
+    const QScrollBar *bar = horizontalScrollBar();
+    const bool followingEnd = bar->maximum() > 0 && bar->value() >= bar->maximum();
+
+    updateScrollBar();
+    if (followingEnd) {
+        setViewStart(timelineEnd() - visibleSpan());
+    } else {
+        setViewStart(viewStart);
+    }
+    viewport()->update();
+}
+
+void GanttChartView::zoomIn()
+{
+    zoomBy(1.25, plotWidth() / 2.0);
+}
+
+void GanttChartView::zoomOut()
+{
+    zoomBy(1.0 / 1.25, plotWidth() / 2.0);
+}
+
+void GanttChartView::zoomToFit()
+{
+    pixelsPerUnit = std::clamp(plotWidth() / static_cast<double>(timelineEnd()), MinPixelsPerUnit, MaxPixelsPerUnit);
+    updateScrollBar();
+    setViewStart(0.0);
+}
+
+int GanttChartView::laneCount() const
+{
+    return engine ? engine->coreCount() : 1;
+}
+
+int GanttChartView::visibleLanes() const
+{
+    return std::clamp((viewport()->height() - TopMargin - AxisHeight) / LaneHeight, 1, laneCount());
+}
+
+int GanttChartView::firstLane() const
+{
+    return std::min(verticalScrollBar()->value(), laneCount() - visibleLanes());
+}
+
+int GanttChartView::laneAt(int y) const
+{
+    if (y < TopMargin) {
+        return -1;
+    }
+    const int offset = (y - TopMargin) / LaneHeight;
+    return offset < visibleLanes() ? firstLane() + offset : -1;
+}
+
+SimTime GanttChartView::timelineEnd() const
+{
+    return engine ? std::max<SimTime>(engine->currentTime() + 1, 1) : 1;
+}
+
+SimTime GanttChartView::segmentEnd(const ExecutionSegment &segment) const
+{
+    // Exclusive end; an open segment runs up to the current tick
+    return (segment.end == -1 ? engine->currentTime() : segment.end) + 1;
+}
+
+int GanttChartView::plotWidth() const
+{
+    return std::max(viewport()->width() - LabelWidth, 1);
+}
+
+double GanttChartView::visibleSpan() const
+{
+    return plotWidth() / pixelsPerUnit;
+}
+
+double GanttChartView::timeAt(double x) const
+{
+    return viewStart + (x - LabelWidth) / pixelsPerUnit;
+}
+
+int GanttChartView::segmentAt(int core, double time) const
+{
+    if (!engine) {
+        return -1;
+    }
+
+    const std::vector<ExecutionSegment> &segments = engine->segments(core);
+    auto it = std::upper_bound(segments.begin(), segments.end(), time, [](double t, const ExecutionSegment &segment) {
+        return t < segment.start;
+    });
+    if (it == segments.begin()) {
+        return -1;
+    }
+    --it;
+    return time < segmentEnd(*it) ? static_cast<int>(it - segments.begin()) : -1;
+}
+
+void GanttChartView::zoomBy(double factor, double anchorX)
+{
+    const double anchorTime = timeAt(LabelWidth + anchorX);
+    pixelsPerUnit = std::clamp(pixelsPerUnit * factor, MinPixelsPerUnit, MaxPixelsPerUnit);
+    updateScrollBar();
+    setViewStart(anchorTime - anchorX / pixelsPerUnit);
+}
+
+void GanttChartView::setViewStart(double start)
+{
+    const double maxStart = std::max(0.0, timelineEnd() - visibleSpan());
+    viewStart = std::clamp(start, 0.0, maxStart);
+
+    updatingScrollBar = true;
+    horizontalScrollBar()->setValue(static_cast<int>(std::min(viewStart, static_cast<double>(INT_MAX))));
+    updatingScrollBar = false;
+    viewport()->update();
+}
+
+void GanttChartView::updateScrollBar()
+{
+    // The scroll bar works in time units, independent of the zoom level
+    const double span = visibleSpan();
+    const double maxStart = std::max(0.0, timelineEnd() - span);
+
+    updatingScrollBar = true;
+    QScrollBar *bar = horizontalScrollBar();
+    bar->setRange(0, static_cast<int>(std::min(std::ceil(maxStart), static_cast<double>(INT_MAX))));
+    bar->setPageStep(static_cast<int>(std::clamp(span, 1.0, static_cast<double>(INT_MAX))));
+    bar->setSingleStep(static_cast<int>(std::clamp(span / 10.0, 1.0, static_cast<double>(INT_MAX))));
+
+    // The vertical one scrolls whole lanes
+    QScrollBar *laneBar = verticalScrollBar();
+    laneBar->setRange(0, laneCount() - visibleLanes());
+    laneBar->setPageStep(visibleLanes());
+    updatingScrollBar = false;
+}
+
+void GanttChartView::scrollContentsBy(int dx, int dy)
+{
+    Q_UNUSED(dy);
+    if (dx != 0 && !updatingScrollBar) {
+        viewStart = horizontalScrollBar()->value();
+    }
+    viewport()->update();
+}
+
+void GanttChartView::resizeEvent(QResizeEvent *event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBar();
+    setViewStart(viewStart);
+}
+
+void GanttChartView::wheelEvent(QWheelEvent *event)
+{
+    const double steps = event->angleDelta().y() / 120.0;
+    if (event->modifiers() & Qt::ShiftModifier) {
+        setViewStart(viewStart - steps * visibleSpan() / 10.0);
+    } else {
+        zoomBy(std::pow(1.25, steps), std::max(event->position().x() - LabelWidth, 0.0));
+    }
+    event->accept();
+}
+
+void GanttChartView::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        dragging = true;
+        dragOrigin = event->pos();
+        dragViewStart = viewStart;
+        viewport()->setCursor(Qt::ClosedHandCursor);
+    }
+}
+
+void GanttChartView::mouseMoveEvent(QMouseEvent *event)
+{
+    if (dragging) {
+        setViewStart(dragViewStart - (event->pos().x() - dragOrigin.x()) / pixelsPerUnit);
+    }
+}
+
+void GanttChartView::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        dragging = false;
+        viewport()->unsetCursor();
+    }
+}
+
+bool GanttChartView::viewportEvent(QEvent *event)
+{
+    if (event->type() == QEvent::ToolTip && engine) {
+        QHelpEvent *helpEvent = static_cast<QHelpEvent *>(event);
+        const QPoint pos = helpEvent->pos();
+        const int lane = laneAt(pos.y());
+
+        // The label column shows the core's utilisation
+        if (lane != -1 && pos.x() < LabelWidth) {
+            const double utilization = engine->currentTime() > 0
+                ? engine->coreBusyTime(lane) * 100.0 / engine->currentTime()
+                : 0.0;
+            QToolTip::showText(helpEvent->globalPos(),
+                               QString("CPU %1\nUtilization: %2%").arg(lane).arg(utilization, 0, 'f', 1),
+                               viewport());
+            return true;
+        }
+
+        const int index = lane != -1 ? segmentAt(lane, timeAt(pos.x())) : -1;
+        if (index == -1) {
+            QToolTip::hideText();
+            event->ignore();
+            return true;
+        }
+
+        const ExecutionSegment &segment = engine->segments(lane)[index];
+        const QString end = segment.end == -1 ? QString("running") : QString::number(segment.end);
+        QToolTip::showText(helpEvent->globalPos(),
+                           QString("P%1\nStart: %2\nEnd: %3")
+                               .arg(engine->processes().id[segment.process])
+                               .arg(segment.start)
+                               .arg(end),
+                           viewport());
+        return true;
+    }
+    return QAbstractScrollArea::viewportEvent(event);
+}
+
+void GanttChartView::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(viewport());
+    painter.fillRect(viewport()->rect(), palette().base());
+    if (!engine) {
+        return;
+    }
+
+    const ProcessStore &store = engine->processes();
+    const int width = plotWidth();
+    const double left = viewStart;
+    const double right = viewStart + visibleSpan();
+    const int lanes = visibleLanes();
+    const int topLane = firstLane();
+    const int axisY = TopMargin + lanes * LaneHeight + AxisGap;
+
+    for (int lane = topLane; lane < topLane + lanes; ++lane) {
+        const int laneTop = TopMargin + (lane - topLane) * LaneHeight;
+
+        // Behind the label, a bar as long as the core's utilisation
+        if (engine->currentTime() > 0) {
+            const double utilization = static_cast<double>(engine->coreBusyTime(lane)) / engine->currentTime();
+            painter.fillRect(QRectF(0, laneTop, (LabelWidth - 5) * utilization, LaneHeight - 5), palette().alternateBase());
+        }
+        painter.setPen(palette().color(QPalette::Text));
+        painter.drawText(QRect(0, laneTop, LabelWidth - 5, LaneHeight), Qt::AlignRight | Qt::AlignVCenter,
+                         laneCount() == 1 ? QString("CPU") : QString("CPU %1").arg(lane));
+
+        painter.save();
+        painter.setClipRect(LabelWidth, 0, width, viewport()->height());
+
+        // Visible slice of the lane's segment index
+        const std::vector<ExecutionSegment> &segments = engine->segments(lane);
+        auto first = std::partition_point(segments.begin(), segments.end(), [&](const ExecutionSegment &segment) {
+            return segmentEnd(segment) <= left;
+        });
+        auto last = std::partition_point(first, segments.end(), [&](const ExecutionSegment &segment) {
+            return segment.start < right;
+        });
+
+        if (last - first <= width) {
+            // Few enough segments to draw each one as a labelled block
+            for (auto it = first; it != last; ++it) {
+                const double x = LabelWidth + (it->start - left) * pixelsPerUnit;
+                const double w = (segmentEnd(*it) - it->start) * pixelsPerUnit;
+                const QRectF rect(x, laneTop, w, LaneHeight - 5);
+                const int processId = store.id[it->process];
+
+                painter.setPen(QPen(Qt::black));
+                painter.setBrush(processColor(processId));
+                painter.drawRect(rect);
+
+                const QString label = QString("P%1").arg(processId);
+                if (w > painter.fontMetrics().horizontalAdvance(label) + 6) {
+                    painter.setPen(Qt::white);
+                    painter.drawText(rect, Qt::AlignCenter, label);
+                }
+            }
+        } else {
+            // More segments than pixels: sample one segment per pixel column
+            for (int x = 0; x < width; ++x) {
+                const int index = segmentAt(lane, left + x / pixelsPerUnit);
+                if (index != -1) {
+                    painter.fillRect(LabelWidth + x, laneTop, 1, LaneHeight - 5, processColor(store.id[segments[index].process]));
+                }
+            }
+        }
+
+        painter.restore();
+    }
+
+    painter.save();
+    painter.setClipRect(LabelWidth, 0, width, viewport()->height());
+
+    // Time axis with ticks at a 1/2/5 step that keeps labels apart
+    painter.setPen(QPen(Qt::black, 2));
+    painter.drawLine(LabelWidth, axisY, LabelWidth + width, axisY);
+
+    const double minStep = MinTickSpacing / pixelsPerUnit;
+    double step = std::pow(10.0, std::floor(std::log10(std::max(minStep, 1.0))));
+    while (step < minStep) {
+        step *= (step * 2 >= minStep) ? 2 : 5;
+    }
+
+    painter.setPen(QPen(Qt::black, 1));
+    for (double t = std::ceil(left / step) * step; t <= right; t += step) {
+        const int x = LabelWidth + static_cast<int>((t - left) * pixelsPerUnit);
+        painter.drawLine(x, axisY - 5, x, axisY + 5);
+        painter.drawText(x - 5, axisY + 20, QString::number(static_cast<qint64>(t)));
+    }
+
+    painter.restore();
+}
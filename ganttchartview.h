@@ -0,0 +1,66 @@
+#ifndef GANTTCHARTVIEW_H
+#define GANTTCHARTVIEW_H
+
+#include <QAbstractScrollArea>
+#include <QColor>
+#include <QPoint>
+
+#include "schedulerengine.h"
+
+// Gantt chart that paints straight from the engine's execution segments, one
+// lane per core. Only the lanes, segments and axis ticks inside the viewport
+// are visited, so the cost of a repaint depends on what is on screen, not on
+// the timeline length or the core count.
+class GanttChartView : public QAbstractScrollArea
+{
+    Q_OBJECT
+
+public:
+    explicit GanttChartView(QWidget *parent = nullptr);
+
+    void setEngine(const SchedulerEngine *engine);
+
+    // Picks up new segments; keeps following the live edge if it was in view
+    void refresh();
+
+    void zoomIn();
+    void zoomOut();
+    void zoomToFit();
+
+    static QColor processColor(int processId);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void scrollContentsBy(int dx, int dy) override;
+    bool viewportEvent(QEvent *event) override;
+
+private:
+    const SchedulerEngine *engine;
+    double pixelsPerUnit;
+    double viewStart;
+    bool updatingScrollBar;
+    bool dragging;
+    QPoint dragOrigin;
+    double dragViewStart;
+
+    int laneCount() const;
+    int visibleLanes() const;
+    int firstLane() const;
+    int laneAt(int y) const;
+    SimTime timelineEnd() const;
+    SimTime segmentEnd(const ExecutionSegment &segment) const;
+    int plotWidth() const;
+    double visibleSpan() const;
+    double timeAt(double x) const;
+    int segmentAt(int core, double time) const;
+    void zoomBy(double factor, double anchorX);
+    void setViewStart(double start);
+    void updateScrollBar();
+};
+
+#endif // GANTTCHARTVIEW_H
@@ -0,0 +1,141 @@
+#include "generatordialog.h"
+
+#include <QComboBox>
+#include <QDateTime>
+#include <QDialogButtonBox>
+#include <QDoubleSpinBox>
+#include <QFormLayout>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QSpinBox>
+#include <QStringList>
+#include <QVBoxLayout>
+
+#include <climits>
+
+namespace {
+
+QDoubleSpinBox *makeSpinBox(double minimum, double maximum, double value, int decimals, QWidget *parent)
+{
+    QDoubleSpinBox *spinBox = new QDoubleSpinBox(parent);
+    spinBox->setRange(minimum, maximum);
+    spinBox->setDecimals(decimals);
+    spinBox->setValue(value);
+    return spinBox;
+}
+
+} // namespace
+
+GeneratorDialog::GeneratorDialog(QWidget *parent)
+    : QDialog(parent)
+{
+    setWindowTitle("Generate Workload");
+    const WorkloadSpec defaults;
+
+    countSpinBox = new QSpinBox(this);
+    countSpinBox->setRange(1, INT_MAX);
+    countSpinBox->setGroupSeparatorShown(true);
+    countSpinBox->setValue(defaults.count);
+    // A fresh seed each time; type one in to get the same workload again
+    seedEdit = new QLineEdit(QString::number(QDateTime::currentMSecsSinceEpoch()), this);
+
+    arrivalsComboBox = new QComboBox(this);
+    arrivalsComboBox->addItem("Poisson", static_cast<int>(ArrivalPattern::Poisson));
+    arrivalsComboBox->addItem("Bursty", static_cast<int>(ArrivalPattern::Bursty));
+    rateSpinBox = makeSpinBox(0.0001, 1000.0, defaults.arrivalRate, 4, this);
+    clusterSizeSpinBox = makeSpinBox(1.0, 1e6, defaults.clusterSize, 1, this);
+    intensitySpinBox = makeSpinBox(1.0, 1e6, defaults.burstIntensity, 1, this);
+
+    burstsComboBox = new QComboBox(this);
+    burstsComboBox->addItem("Exponential", static_cast<int>(BurstDistribution::Exponential));
+    burstsComboBox->addItem("Pareto", static_cast<int>(BurstDistribution::Pareto));
+    burstsComboBox->addItem("Bimodal", static_cast<int>(BurstDistribution::Bimodal));
+    meanBurstSpinBox = makeSpinBox(0.01, 1e6, defaults.meanBurst, 2, this);
+    shapeSpinBox = makeSpinBox(1.01, 100.0, defaults.paretoShape, 2, this);
+    shortBurstSpinBox = makeSpinBox(0.01, 1e6, defaults.shortBurst, 2, this);
+    longBurstSpinBox = makeSpinBox(0.01, 1e6, defaults.longBurst, 2, this);
+    shortFractionSpinBox = makeSpinBox(0.0, 1.0, defaults.shortFraction, 3, this);
+
+    QStringList weights;
+    for (double weight : defaults.priorityWeights) {
+        weights << QString::number(weight);
+    }
+    prioritiesEdit = new QLineEdit(weights.join(","), this);
+    prioritiesEdit->setToolTip("Relative weights of priority 1, 2, 3, ...");
+
+    QFormLayout *form = new QFormLayout();
+    form->addRow("Processes:", countSpinBox);
+    form->addRow("Seed:", seedEdit);
+    form->addRow("Arrivals:", arrivalsComboBox);
+    form->addRow("Arrival rate (per tick):", rateSpinBox);
+    form->addRow("Mean cluster size:", clusterSizeSpinBox);
+    form->addRow("Cluster intensity:", intensitySpinBox);
+    form->addRow("Burst times:", burstsComboBox);
+    form->addRow("Mean burst:", meanBurstSpinBox);
+    form->addRow("Pareto shape:", shapeSpinBox);
+    form->addRow("Short burst mean:", shortBurstSpinBox);
+    form->addRow("Long burst mean:", longBurstSpinBox);
+    form->addRow("Short fraction:", shortFractionSpinBox);
+    form->addRow("Priority weights:", prioritiesEdit);
+
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, this);
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addLayout(form);
+    layout->addWidget(buttons);
+
+    connect(arrivalsComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &GeneratorDialog::updateEnabledFields);
+    connect(burstsComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &GeneratorDialog::updateEnabledFields);
+    connect(buttons, &QDialogButtonBox::accepted, this, &GeneratorDialog::validateAndAccept);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+    updateEnabledFields();
+}
+
+WorkloadSpec GeneratorDialog::workloadSpec() const
+{
+    WorkloadSpec spec;
+    spec.count = countSpinBox->value();
+    spec.seed = seedEdit->text().trimmed().toULongLong();
+    spec.arrivals = static_cast<ArrivalPattern>(arrivalsComboBox->currentData().toInt());
+    spec.arrivalRate = rateSpinBox->value();
+    spec.clusterSize = clusterSizeSpinBox->value();
+    spec.burstIntensity = intensitySpinBox->value();
+    spec.bursts = static_cast<BurstDistribution>(burstsComboBox->currentData().toInt());
+    spec.meanBurst = meanBurstSpinBox->value();
+    spec.paretoShape = shapeSpinBox->value();
+    spec.shortBurst = shortBurstSpinBox->value();
+    spec.longBurst = longBurstSpinBox->value();
+    spec.shortFraction = shortFractionSpinBox->value();
+    spec.priorityWeights.clear();
+    for (const QString &weight : prioritiesEdit->text().split(',')) {
+        bool valid = false;
+        const double value = weight.trimmed().toDouble(&valid);
+        spec.priorityWeights.push_back(valid ? value : -1.0);
+    }
+    return spec;
+}
+
+void GeneratorDialog::updateEnabledFields()
+{
+    const bool bursty = arrivalsComboBox->currentData().toInt() == static_cast<int>(ArrivalPattern::Bursty);
+    clusterSizeSpinBox->setEnabled(bursty);
+    intensitySpinBox->setEnabled(bursty);
+
+    const BurstDistribution bursts = static_cast<BurstDistribution>(burstsComboBox->currentData().toInt());
+    meanBurstSpinBox->setEnabled(bursts != BurstDistribution::Bimodal);
+    shapeSpinBox->setEnabled(bursts == BurstDistribution::Pareto);
+    shortBurstSpinBox->setEnabled(bursts == BurstDistribution::Bimodal);
+    longBurstSpinBox->setEnabled(bursts == BurstDistribution::Bimodal);
+    shortFractionSpinBox->setEnabled(bursts == BurstDistribution::Bimodal);
+}
+
+void GeneratorDialog::validateAndAccept()
+{
+    bool seedValid = false;
+    seedEdit->text().trimmed().toULongLong(&seedValid);
+    std::string errorMessage = "the seed must be a non-negative integer";
+    if (!seedValid || !validateWorkloadSpec(workloadSpec(), &errorMessage)) {
+        QMessageBox::warning(this, "Invalid Parameters", "Cannot generate the workload: " + QString::fromStdString(errorMessage) + ".");
+        return;
+    }
+    accept();
+}
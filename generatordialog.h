@@ -0,0 +1,44 @@
+#ifndef GENERATORDIALOG_H
+#define GENERATORDIALOG_H
+
+#include <QDialog>
+
+#include "workloadgenerator.h"
+
+class QComboBox;
+class QDoubleSpinBox;
+class QLineEdit;
+class QSpinBox;
+
+// Collects the parameters of a synthetic workload. Only the fields of the
+// chosen arrival pattern and burst distribution are enabled.
+class GeneratorDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit GeneratorDialog(QWidget *parent = nullptr);
+
+    WorkloadSpec workloadSpec() const;
+
+private slots:
+    void updateEnabledFields();
+    void validateAndAccept();
+
+private:
+    QSpinBox *countSpinBox;
+    QLineEdit *seedEdit;
+    QComboBox *arrivalsComboBox;
+    QDoubleSpinBox *rateSpinBox;
+    QDoubleSpinBox *clusterSizeSpinBox;
+    QDoubleSpinBox *intensitySpinBox;
+    QComboBox *burstsComboBox;
+    QDoubleSpinBox *meanBurstSpinBox;
+    QDoubleSpinBox *shapeSpinBox;
+    QDoubleSpinBox *shortBurstSpinBox;
+    QDoubleSpinBox *longBurstSpinBox;
+    QDoubleSpinBox *shortFractionSpinBox;
+    QLineEdit *prioritiesEdit;
+};
+
+#endif // GENERATORDIALOG_H
@@ -0,0 +1,120 @@
+#include "latencyhistogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+int highestBit(std::uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value);
+#else
+    int bit = 0;
+    for (int step = 32; step > 0; step /= 2) {
+        if (value >> step) {
+            value >>= step;
+            bit += step;
+        }
+    }
+    return bit;
+#endif
+}
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram()
+    : counts(BucketCount, 0)
+    , total(0)
+    , maximum(0)
+{
+}
+
+void LatencyHistogram::record(std::int64_t value)
+{
+    value = std::max<std::int64_t>(value, 0);
+    ++counts[bucketOf(value)];
+    ++total;
+    maximum = std::max(maximum, value);
+}
+
+void LatencyHistogram::remove(std::int64_t value)
+{
+    --counts[bucketOf(std::max<std::int64_t>(value, 0))];
+    --total;
+}
+
+void LatencyHistogram::clear()
+{
+    std::fill(counts.begin(), counts.end(), 0);
+    total = 0;
+    maximum = 0;
+}
+
+std::int64_t LatencyHistogram::percentile(double percent) const
+{
+    std::int64_t value = 0;
+    percentiles(&percent, 1, &value);
+    return value;
+}
+
+LatencySummary LatencyHistogram::summary() const
+{
+    const double percents[] = { 50.0, 90.0, 99.0, 99.9 };
+    std::int64_t values[4];
+    percentiles(percents, 4, values);
+
+    LatencySummary result;
+    result.p50 = values[0];
+    result.p90 = values[1];
+    result.p99 = values[2];
+    result.p999 = values[3];
+    result.max = maximum;
+    return result;
+}
+
+int LatencyHistogram::bucketOf(std::int64_t value)
+{
+    if (value < SubBucketCount) {
+        return static_cast<int>(value);
+    }
+    // value >> shift falls in [HalfBucketCount, SubBucketCount)
+    const int shift = highestBit(static_cast<std::uint64_t>(value)) - (SubBucketBits - 1);
+    return SubBucketCount + (shift - 1) * HalfBucketCount + static_cast<int>((value >> shift) - HalfBucketCount);
+}
+
+std::int64_t LatencyHistogram::bucketUpperBound(int bucket)
+{
+    if (bucket < SubBucketCount) {
+        return bucket;
+    }
+    const int shift = (bucket - SubBucketCount) / HalfBucketCount + 1;
+    const std::int64_t subBucket = (bucket - SubBucketCount) % HalfBucketCount + HalfBucketCount;
+    // The top bucket reaches the largest int64, which its bound would overflow
+    if (subBucket + 1 > (std::numeric_limits<std::int64_t>::max() >> shift)) {
+        return std::numeric_limits<std::int64_t>::max();
+    }
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::percentiles(const double *percents, int count, std::int64_t *values) const
+{
+    // Percents come in ascending order, so one walk over the buckets answers all of them.
+    // Ranks are taken in parts per million so 99.9% of 1000 values is exactly rank 999.
+    int bucket = 0;
+    std::int64_t seen = 0;
+    for (int i = 0; i < count; ++i) {
+        if (total == 0) {
+            values[i] = 0;
+            continue;
+        }
+        const std::int64_t partsPerMillion = std::llround(std::min(std::max(percents[i], 0.0), 100.0) * 10000.0);
+        const std::int64_t rank = std::max<std::int64_t>((total * partsPerMillion + 999999) / 1000000, 1);
+        while (seen + counts[bucket] < rank) {
+            seen += counts[bucket];
+            ++bucket;
+        }
+        values[i] = std::min(bucketUpperBound(bucket), maximum);
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <cstdint>
+#include <vector>
+
+struct LatencySummary
+{
+    std::int64_t p50 = 0;
+    std::int64_t p90 = 0;
+    std::int64_t p99 = 0;
+    std::int64_t p999 = 0;
+    std::int64_t max = 0;
+};
+
+// Log-linear histogram of non-negative durations in fixed memory, in the
+// style of HdrHistogram. Values below 256 have a bucket each; above that every
+// power of two is split into 128 buckets, so percentiles are exact up to 255
+// and within 0.8% beyond (reported as the bucket's upper bound, never above
+// the maximum). Recording is O(1) and the histogram never grows, however many
+// values it sees; a summary walks its 7296 buckets once.
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    void record(std::int64_t value);
+    void clear();
+
+    // Takes back a value recorded earlier, for rewinding a run. The maximum
+    // is left as it was; restoreMax() puts back the one from before the value.
+    void remove(std::int64_t value);
+    void restoreMax(std::int64_t value) { maximum = value; }
+
+    std::int64_t count() const { return total; }
+    std::int64_t max() const { return maximum; }
+
+    // Nearest-rank percentile, 0 while empty
+    std::int64_t percentile(double percent) const;
+    LatencySummary summary() const;
+
+private:
+    static const int SubBucketBits = 8;
+    static const int SubBucketCount = 1 << SubBucketBits;
+    static const int HalfBucketCount = SubBucketCount / 2;
+    static const int BucketCount = SubBucketCount + (62 - SubBucketBits + 1) * HalfBucketCount;
+
+    std::vector<std::int64_t> counts;
+    std::int64_t total;
+    std::int64_t maximum;
+
+    static int bucketOf(std::int64_t value);
+    static std::int64_t bucketUpperBound(int bucket);
+    void percentiles(const double *percents, int count, std::int64_t *values) const;
+};
+
+#endif // LATENCYHISTOGRAM_H
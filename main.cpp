@@ -1,11 +1,305 @@
 #include "mainwindow.h"
+#include "eventjournal.h"
+#include "sweeprunner.h"
+#include "tracewriter.h"
+#include "workloadgenerator.h"
+#include "workloadio.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
 #include <QLocale>
+#include <QTextStream>
+#include <QThreadPool>
 #include <QTranslator>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+static bool isBatchMode(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--batch") == 0 || std::strcmp(argv[i], "--generate") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static QString percentileLine(const char *metric, const LatencyHistogram &histogram)
+{
+    const LatencySummary summary = histogram.summary();
+    return QString("%1 P50/P90/P99/P99.9/Max: %2 / %3 / %4 / %5 / %6\n")
+        .arg(metric).arg(summary.p50).arg(summary.p90).arg(summary.p99).arg(summary.p999).arg(summary.max);
+}
+
+// Simulates every point of the grid on the global thread pool and writes one CSV row per point
+static int runSweep(const ProcessStore &workload, const QString &gridText, const QString &outputFile)
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    SweepGrid grid;
+    std::string errorMessage;
+    if (!parseSweepGrid(gridText.toStdString(), grid, &errorMessage)) {
+        err << "Invalid sweep: " << QString::fromStdString(errorMessage) << "\n";
+        return 1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const std::vector<SweepPoint> points = expandSweepGrid(grid);
+    const std::vector<SweepResult> results = QtConcurrent::blockingMapped<std::vector<SweepResult>>(
+        points, [&workload](const SweepPoint &point) {
+            return runSweepPoint(workload, point);
+        });
+    const qint64 sweepNs = timer.nsecsElapsed();
+
+    const std::string csv = formatSweepCsv(results);
+    if (outputFile.isEmpty()) {
+        out << QString::fromStdString(csv);
+    } else {
+        QFile file(outputFile);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)
+            || file.write(csv.data(), static_cast<qint64>(csv.size())) != static_cast<qint64>(csv.size())) {
+            err << outputFile << ": could not write sweep results\n";
+            return 1;
+        }
+    }
+
+    // Timing goes to stderr so the CSV can be piped
+    err << "Sweep points: " << points.size() << "\n"
+        << "Threads: " << QThreadPool::globalInstance()->maxThreadCount() << "\n"
+        << "Sweep time: " << QString::number(sweepNs / 1e6, 'f', 2) << " ms\n";
+    return 0;
+}
+
+// Rebuilds the results of a journalled run of workload instead of simulating it
+static int runReplay(ProcessStore &workload, const QString &journalFile, const QString &outputFile)
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QElapsedTimer timer;
+    timer.start();
+    JournalReplay replay;
+    std::string replayError;
+    if (!replayJournal(QFile::encodeName(journalFile).toStdString(), workload, std::numeric_limits<SimTime>::max(),
+                       nullptr, &replay, &replayError)) {
+        err << journalFile << ": " << QString::fromStdString(replayError) << "\n";
+        return 1;
+    }
+    const qint64 replayNs = timer.nsecsElapsed();
+
+    if (!outputFile.isEmpty()) {
+        QString errorMessage;
+        const bool written = outputFile.endsWith(".simbin", Qt::CaseInsensitive)
+            ? writeWorkloadBinary(outputFile, workload, replay.time, true, &errorMessage)
+            : writeResultsCsv(outputFile, workload, replay.time, &errorMessage);
+        if (!written) {
+            err << outputFile << ": " << errorMessage << "\n";
+            return 1;
+        }
+    }
+
+    const double replaySeconds = replayNs / 1e9;
+    out << "Processes: " << workload.size() << "\n"
+        << "Simulated time: " << replay.time << "\n"
+        << "Replayed events: " << replay.events << "\n"
+        << "Replay time: " << QString::number(replayNs / 1e6, 'f', 2) << " ms\n"
+        << "Events per second: " << QString::number(replaySeconds > 0 ? replay.events / replaySeconds : 0.0, 'f', 0) << "\n";
+    return 0;
+}
+
+// Headless run: load a workload, simulate it to completion and export the results
+static int runBatch(const QCoreApplication &app)
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Process Scheduler Simulator");
+    parser.addHelpOption();
+    parser.addOption({"batch", "Simulate <workload> without opening a window.", "workload"});
+    parser.addOption({"generate", "Simulate a synthetic workload such as \"count=1000000;seed=42;arrivals=bursty;"
+                                  "bursts=pareto\" instead of loading one.", "spec"});
+    parser.addOption({"out", "Write results to <file> (.simbin for the binary format).", "file"});
+    parser.addOption({"policy", "Scheduling policy: fcfs, sjf, srtf, rr, priority or ppriority.", "policy", "fcfs"});
+    parser.addOption({"quantum", "Round Robin time quantum.", "ticks", "4"});
+    parser.addOption({"cores", "Number of simulated cores.", "count", "1"});
+    parser.addOption({"steal", "Let idle cores steal work from busy ones."});
+    parser.addOption({"trace", "Stream the schedule to <file> as Chrome trace-event JSON.", "file"});
+    parser.addOption({"journal", "Record every scheduling event in the event journal <file>.", "file"});
+    parser.addOption({"replay", "Rebuild the results from the event journal <file> instead of simulating.", "file"});
+    parser.addOption({"sweep", "Run a parameter sweep such as \"policy=fcfs,rr;rate=0.5,1,1.5\" "
+                               "instead of a single simulation.", "grid"});
+    parser.process(app);
+
+    const QString inputFile = parser.value("batch");
+    if (inputFile.isEmpty() && !parser.isSet("generate")) {
+        err << "No workload file given to --batch\n";
+        return 1;
+    }
+
+    int policyIndex = 0;
+    while (policyIndex < SchedulingPolicyCount
+           && parser.value("policy") != schedulingPolicyKey(static_cast<SchedulingPolicy>(policyIndex))) {
+        ++policyIndex;
+    }
+    if (policyIndex == SchedulingPolicyCount) {
+        err << "Unknown scheduling policy " << parser.value("policy") << "\n";
+        return 1;
+    }
+    bool quantumValid = false;
+    const qint64 quantum = parser.value("quantum").toLongLong(&quantumValid);
+    if (!quantumValid || quantum < 1) {
+        err << "The quantum must be a positive integer\n";
+        return 1;
+    }
+
+    bool coresValid = false;
+    const int coreCount = parser.value("cores").toInt(&coresValid);
+    if (!coresValid || coreCount < 1 || coreCount > MaxCoreCount) {
+        err << "The core count must be an integer from 1 to " << MaxCoreCount << "\n";
+        return 1;
+    }
+
+    SchedulerEngine engine;
+    engine.setPolicy(static_cast<SchedulingPolicy>(policyIndex), quantum);
+    engine.setCoreCount(coreCount);
+    engine.setWorkStealing(parser.isSet("steal"));
+    engine.setRecordSegments(false);
+    QString errorMessage;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    CsvParseResult parseResult;
+    if (parser.isSet("generate")) {
+        WorkloadSpec spec;
+        std::string specError;
+        if (!parseWorkloadSpec(parser.value("generate").toStdString(), spec, &specError)) {
+            err << "Invalid workload: " << QString::fromStdString(specError) << "\n";
+            return 1;
+        }
+        generateWorkload(spec, engine.processes());
+    } else {
+        const bool loaded = isBinaryWorkloadFile(inputFile)
+            ? loadWorkloadBinary(inputFile, engine.processes(), &errorMessage)
+            : loadWorkloadCsv(inputFile, engine.processes(), &errorMessage, &parseResult);
+        if (!loaded) {
+            err << inputFile << ": " << errorMessage << "\n";
+            return 1;
+        }
+    }
+    for (const CsvParseError &error : parseResult.errors) {
+        err << inputFile << ":" << error.line << ": " << QString::fromStdString(error.message) << "\n";
+    }
+    if (parseResult.errorCount > static_cast<qint64>(parseResult.errors.size())) {
+        err << inputFile << ": " << parseResult.errorCount - static_cast<qint64>(parseResult.errors.size()) << " more malformed rows\n";
+    }
+    const qint64 loadNs = timer.nsecsElapsed();
+
+    if (parser.isSet("sweep")) {
+        return runSweep(engine.processes(), parser.value("sweep"), parser.value("out"));
+    }
+    if (parser.isSet("replay")) {
+        return runReplay(engine.processes(), parser.value("replay"), parser.value("out"));
+    }
+
+    // Traced and journalled runs include writing the files in the simulation time
+    TraceWriter trace;
+    std::string traceError;
+    if (parser.isSet("trace")) {
+        engine.setTrace(&trace);
+    }
+    EventJournal journal;
+    std::string journalError;
+    if (parser.isSet("journal")) {
+        engine.setJournal(&journal);
+    }
+    engine.reset();
+    if (parser.isSet("trace") && !trace.open(QFile::encodeName(parser.value("trace")).toStdString(), engine.coreCount(), &traceError)) {
+        err << parser.value("trace") << ": " << QString::fromStdString(traceError) << "\n";
+        return 1;
+    }
+    if (parser.isSet("journal")
+        && !journal.open(QFile::encodeName(parser.value("journal")).toStdString(), engine.coreCount(),
+                         engine.processes().size(), &journalError)) {
+        err << parser.value("journal") << ": " << QString::fromStdString(journalError) << "\n";
+        return 1;
+    }
+    engine.run();
+    if (!trace.close(engine.currentTime(), &traceError)) {
+        err << parser.value("trace") << ": " << QString::fromStdString(traceError) << "\n";
+        return 1;
+    }
+    if (!journal.close(&journalError)) {
+        err << parser.value("journal") << ": " << QString::fromStdString(journalError) << "\n";
+        return 1;
+    }
+    const qint64 simulateNs = timer.nsecsElapsed() - loadNs;
+
+    if (parser.isSet("out")) {
+        const QString outputFile = parser.value("out");
+        const bool written = outputFile.endsWith(".simbin", Qt::CaseInsensitive)
+            ? writeWorkloadBinary(outputFile, engine.processes(), engine.currentTime(), true, &errorMessage)
+            : writeResultsCsv(outputFile, engine.processes(), engine.currentTime(), &errorMessage);
+        if (!written) {
+            err << parser.value("out") << ": " << errorMessage << "\n";
+            return 1;
+        }
+    }
+    const qint64 totalNs = timer.nsecsElapsed();
+
+    // Spread of the per-core utilisation
+    double minUtilization = 0.0;
+    double maxUtilization = 0.0;
+    if (engine.currentTime() > 0) {
+        minUtilization = 100.0;
+        for (int core = 0; core < engine.coreCount(); ++core) {
+            const double utilization = engine.coreBusyTime(core) * 100.0 / engine.currentTime();
+            minUtilization = std::min(minUtilization, utilization);
+            maxUtilization = std::max(maxUtilization, utilization);
+        }
+    }
+    const double totalUtilization = engine.currentTime() > 0
+        ? engine.busyTime() * 100.0 / (static_cast<double>(engine.currentTime()) * engine.coreCount())
+        : 0.0;
+
+    const double simulateSeconds = simulateNs / 1e9;
+    const double eventsPerSecond = simulateSeconds > 0 ? engine.eventCount() / simulateSeconds : 0.0;
+
+    out << "Policy: " << schedulingPolicyName(engine.policy()) << "\n"
+        << "Cores: " << engine.coreCount() << (engine.workStealing() ? " (work stealing)" : "") << "\n"
+        << "Processes: " << engine.processes().size() << "\n"
+        << "Simulated time: " << engine.currentTime() << "\n"
+        << "Events: " << engine.eventCount() << "\n"
+        << (parser.isSet("trace") ? QString("Trace events: %1\n").arg(trace.eventCount()) : QString())
+        << (parser.isSet("journal") ? QString("Journal: %1 events in %2 bytes\n").arg(journal.eventCount()).arg(journal.byteCount()) : QString())
+        << "CPU utilization: " << QString::number(totalUtilization, 'f', 1) << "% (per core "
+        << QString::number(minUtilization, 'f', 1) << "% to " << QString::number(maxUtilization, 'f', 1) << "%)\n"
+        << percentileLine("Turnaround time", engine.turnaroundHistogram())
+        << percentileLine("Waiting time", engine.waitingHistogram())
+        << percentileLine("Response time", engine.responseHistogram())
+        << "Load time: " << QString::number(loadNs / 1e6, 'f', 2) << " ms\n"
+        << "Simulation time: " << QString::number(simulateNs / 1e6, 'f', 2) << " ms\n"
+        << "Wall-clock time: " << QString::number(totalNs / 1e6, 'f', 2) << " ms\n"
+        << "Events per second: " << QString::number(eventsPerSecond, 'f', 0) << "\n";
+    return 0;
+}
 
 int main(int argc, char *argv[])
 {
+    if (isBatchMode(argc, argv)) {
+        QCoreApplication a(argc, argv);
+        return runBatch(a);
+    }
+
     QApplication a(argc, argv);
 
     QTranslator translator;
@@ -17,8 +311,8 @@ int main(int argc, char *argv[])
             break;
         }
     }
-    
+
     MainWindow w;
     w.show();
     return a.exec();
-}
\ No newline at end of file
+}
@@ -1,26 +1,180 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "processtablemodel.h"
+#include "chartsummary.h"
+#include "downsampler.h"
+#include "ganttchartview.h"
+#include "generatordialog.h"
+#include "profilerdock.h"
+#include "sweepdialog.h"
+#include "tracewriter.h"
+#include "workloadio.h"
 #include <QMessageBox>
 #include <QFileDialog>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QEventLoop>
+#include <QProgressDialog>
+#include <QtConcurrent>
 #include <QTextStream>
 #include <QRandomGenerator>
 #include <QDateTime>
 #include <QBarCategoryAxis>
+#include <QLineSeries>
 #include <QValueAxis>
 #include <QVBoxLayout>
 #include <QtMath>
 #include <QLabel>
+#include <QHeaderView>
+#include <QItemSelectionModel>
+#include <QInputDialog>
+#include <QSignalBlocker>
 #include <QTimer>
-#include <QGraphicsScene>
-#include <QGraphicsRectItem>
-#include <QGraphicsTextItem>
 #include <QMessageBox>
 #include <QDebug>
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <memory>
+
+// The worker ticks at the speed slider's interval; the window shows its progress at about 60 Hz
+static const int DisplayRefreshInterval = 16;
+
+// Upper bound on the points of each over-time chart, however long the run
+static const std::size_t MaxChartPoints = 2000;
+
+// Ticks between the checkpoints a timeline seek restores from
+static const SimTime CheckpointInterval = 1000;
+
+// The timeline slider counts in ints, so past INT_MAX ticks each step spans several
+static int timelinePosition(SimTime time, SimTime furthest)
+{
+    if (furthest <= INT_MAX) {
+        return static_cast<int>(time);
+    }
+    return static_cast<int>(std::llround(static_cast<double>(time) / furthest * INT_MAX));
+}
+
+static SimTime timelineTime(int position, SimTime furthest)
+{
+    if (furthest <= INT_MAX) {
+        return position;
+    }
+    return std::min<SimTime>(std::llround(static_cast<double>(position) / INT_MAX * furthest), furthest);
+}
+
+static QString percentileText(const QString &metric, const LatencyHistogram &histogram)
+{
+    const LatencySummary summary = histogram.summary();
+    return QString("%1 P50/P90/P99/P99.9/Max: %2 / %3 / %4 / %5 / %6")
+        .arg(metric).arg(summary.p50).arg(summary.p90).arg(summary.p99).arg(summary.p999).arg(summary.max);
+}
+
+// Per-process charts show every completed process up to this many, then switch to histograms and top processes
+static const int MaxProcessBars = 50;
+static const int HistogramBins = 20;
+static const int TopProcessCount = 15;
+
+// Gives chart a persistent line series with value axes, updated by showTimeSeries()
+static void setupLineChart(QChart *chart, const QString &name)
+{
+    QLineSeries *series = new QLineSeries();
+    series->setName(name);
+    chart->addSeries(series);
+    
+    QValueAxis *axisX = new QValueAxis();
+    axisX->setLabelFormat("%d");
+    chart->addAxis(axisX, Qt::AlignBottom);
+    series->attachAxis(axisX);
+    
+    QValueAxis *axisY = new QValueAxis();
+    chart->addAxis(axisY, Qt::AlignLeft);
+    series->attachAxis(axisY);
+}
+
+// Gives chart a persistent bar series with one set per name, updated by showBars()
+static void setupBarChart(QChart *chart, const QStringList &setNames)
+{
+    QBarSeries *series = new QBarSeries();
+    for (const QString &name : setNames) {
+        series->append(new QBarSet(name));
+    }
+    chart->addSeries(series);
+    
+    QBarCategoryAxis *axisX = new QBarCategoryAxis();
+    chart->addAxis(axisX, Qt::AlignBottom);
+    series->attachAxis(axisX);
+    
+    QValueAxis *axisY = new QValueAxis();
+    chart->addAxis(axisY, Qt::AlignLeft);
+    series->attachAxis(axisY);
+}
+
+// Replaces the points of chart's line with a downsampled copy of points
+static void showTimeSeries(QChart *chart, const std::vector<SeriesPoint> &points, SimTime interval, double maxY)
+{
+    const std::vector<SeriesPoint> shown = downsampleLttb(points, MaxChartPoints);
+    QVector<QPointF> linePoints;
+    linePoints.reserve(static_cast<int>(shown.size()));
+    for (const SeriesPoint &point : shown) {
+        linePoints.append(QPointF(point.x, point.y));
+    }
+    static_cast<QLineSeries *>(chart->series().first())->replace(linePoints);
+    
+    QValueAxis *axisX = static_cast<QValueAxis *>(chart->axes(Qt::Horizontal).first());
+    axisX->setTitleText(QString("Time (%1-tick windows)").arg(interval));
+    axisX->setRange(0, points.empty() ? 1.0 : points.back().x);
+    static_cast<QValueAxis *>(chart->axes(Qt::Vertical).first())->setRange(0, maxY > 0 ? maxY : 1.0);
+}
+
+// Replaces the values of chart's bar sets, one list per set, and fits the value axis to them
+static void showBars(QChart *chart, const QStringList &categories, const QVector<QList<qreal>> &values,
+                     const QString &valueTitle)
+{
+    const QList<QBarSet *> sets = static_cast<QBarSeries *>(chart->series().first())->barSets();
+    qreal maxValue = 0;
+    for (int i = 0; i < sets.size(); ++i) {
+        sets[i]->remove(0, sets[i]->count());
+        sets[i]->append(values[i]);
+        for (qreal value : values[i]) {
+            maxValue = qMax(maxValue, value);
+        }
+    }
+    static_cast<QBarCategoryAxis *>(chart->axes(Qt::Horizontal).first())->setCategories(categories);
+    
+    QValueAxis *axisY = static_cast<QValueAxis *>(chart->axes(Qt::Vertical).first());
+    axisY->setTitleText(valueTitle);
+    axisY->setRange(0, maxValue > 0 ? maxValue : 1.0);
+    axisY->applyNiceNumbers();
+}
+
+static QStringList binLabels(const MetricHistogram &histogram)
+{
+    QStringList labels;
+    for (int bin = 0; bin < static_cast<int>(histogram.counts.size()); ++bin) {
+        const SimTime low = bin * histogram.binWidth;
+        labels << (histogram.binWidth == 1 ? QString::number(low) : QString("%1-%2").arg(low).arg(low + histogram.binWidth - 1));
+    }
+    return labels;
+}
+
+static QList<qreal> binCounts(const MetricHistogram &histogram)
+{
+    QList<qreal> counts;
+    counts.reserve(static_cast<int>(histogram.counts.size()));
+    for (std::int64_t count : histogram.counts) {
+        counts << static_cast<qreal>(count);
+    }
+    return counts;
+}
+
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , currentTime(0)
+    , furthestTime(0)
     , currentProcessIndex(-1)
     , simulationRunning(false)
 {
@@ -29,14 +183,13 @@ MainWindow::MainWindow(QWidget *parent)
     // Initialize random seed
     QRandomGenerator::global()->seed(QDateTime::currentMSecsSinceEpoch());
     
-    // Setup graphics scene for Gantt chart
-    ganttChartScene = new QGraphicsScene(this);
-    ui->ganttChartView->setScene(ganttChartScene);
-    
-    // Initialize simulation timer
+    // Initialize display refresh timer
     simulationTimer = new QTimer(this);
     connect(simulationTimer, &QTimer::timeout, this, &MainWindow::simulationStep);
     
+    // The worker copies the interval with the other settings
+    engine.setCheckpointInterval(CheckpointInterval);
+    
     // Setup process table
     setupProcessTable();
     
@@ -46,6 +199,12 @@ MainWindow::MainWindow(QWidget *parent)
     // Setup performance charts
     setupPerformanceCharts();
     
+    // Setup scheduling policy selection
+    setupSchedulingControls();
+    
+    // Setup the profiler overlay, hidden until asked for
+    setupProfiler();
+    
     // Connect slider value changed signal
     connect(ui->speedSlider, &QSlider::valueChanged, this, &MainWindow::on_speedSlider_valueChanged);
     
@@ -62,28 +221,60 @@ MainWindow::MainWindow(QWidget *parent)
 
 MainWindow::~MainWindow()
 {
+    // The dock refers to the profiler and the worker, which go before the child widgets
+    delete profilerDock;
     delete ui;
 }
 
 void MainWindow::setupProcessTable()
 {
-    ui->processTableWidget->setColumnCount(10);
-    ui->processTableWidget->setHorizontalHeaderLabels({
-        "ID", "Arrival Time", "Burst Time", "Priority", "Start Time",
-        "Completion Time", "Turnaround Time", "Waiting Time", "Response Time", "Status"
-    });
-    ui->processTableWidget->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    ui->processTableWidget->verticalHeader()->setVisible(false);
-    ui->processTableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
-    ui->processTableWidget->setSelectionBehavior(QAbstractItemView::SelectRows);
-    ui->processTableWidget->setSelectionMode(QAbstractItemView::SingleSelection);
+    processTableModel = new ProcessTableModel(&engine.processes(), this);
+    ui->processTableView->setModel(processTableModel);
+    ui->processTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    ui->processTableView->verticalHeader()->setVisible(false);
+    // Fixed row heights keep scrolling independent of the row count
+    ui->processTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    ui->processTableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    ui->processTableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    ui->processTableView->setSelectionMode(QAbstractItemView::ExtendedSelection);
 }
 
 void MainWindow::setupGanttChart()
 {
-    ganttChartScene->clear();
-    ui->ganttChartView->setAlignment(Qt::AlignLeft | Qt::AlignTop);
-    ui->ganttChartView->setRenderHint(QPainter::Antialiasing);
+    ui->ganttChartView->setEngine(&engine);
+}
+
+void MainWindow::setupSchedulingControls()
+{
+    // Filled in without signals so the engine is not reset during construction
+    const QSignalBlocker blocker(ui->policyComboBox);
+    for (int i = 0; i < SchedulingPolicyCount; ++i) {
+        ui->policyComboBox->addItem(schedulingPolicyName(static_cast<SchedulingPolicy>(i)), i);
+    }
+    ui->policyComboBox->setCurrentIndex(static_cast<int>(engine.policy()));
+    ui->quantumSpinBox->setValue(static_cast<int>(engine.timeQuantum()));
+    ui->coresSpinBox->setValue(engine.coreCount());
+    ui->workStealingCheckBox->setChecked(engine.workStealing());
+}
+
+void MainWindow::setupProfiler()
+{
+    profilerDock = new ProfilerDock(&profiler, this);
+    addDockWidget(Qt::RightDockWidgetArea, profilerDock);
+    profilerDock->hide();
+    connect(profilerDock, &ProfilerDock::profilingChanged, this, [this](bool enabled) {
+        simulationWorker.setTimingEnabled(enabled);
+    });
+    
+    // Paints happen after the update calls return, so they are timed on their own
+    profiler.watchPaint(ui->processTableView->viewport(), ProfilePhase::TablePaint);
+    profiler.watchPaint(ui->ganttChartView->viewport(), ProfilePhase::GanttPaint);
+    
+    QAction *profilerAction = profilerDock->toggleViewAction();
+    profilerAction->setText("Profiler");
+    profilerAction->setShortcut(QKeySequence("Ctrl+Shift+P"));
+    ui->menuSimulation->addSeparator();
+    ui->menuSimulation->addAction(profilerAction);
 }
 
 void MainWindow::setupPerformanceCharts()
@@ -91,7 +282,7 @@ void MainWindow::setupPerformanceCharts()
     // CPU Utilization Chart
     cpuUtilizationChart = new QChart();
     cpuUtilizationChart->setTitle("CPU Utilization Over Time");
-    cpuUtilizationChart->setAnimationOptions(QChart::SeriesAnimations);
+    setupLineChart(cpuUtilizationChart, "CPU Utilization (%)");
     cpuUtilizationView = new QChartView(cpuUtilizationChart);
     cpuUtilizationView->setRenderHint(QPainter::Antialiasing);
     QVBoxLayout *cpuUtilizationLayout = new QVBoxLayout(ui->cpuUtilizationTab);
@@ -100,7 +291,7 @@ void MainWindow::setupPerformanceCharts()
     // Waiting Time Chart
     waitingTimeChart = new QChart();
     waitingTimeChart->setTitle("Waiting Time per Process");
-    waitingTimeChart->setAnimationOptions(QChart::SeriesAnimations);
+    setupBarChart(waitingTimeChart, QStringList() << "Waiting Time");
     waitingTimeView = new QChartView(waitingTimeChart);
     waitingTimeView->setRenderHint(QPainter::Antialiasing);
     QVBoxLayout *waitingTimeLayout = new QVBoxLayout(ui->waitingTimeTab);
@@ -109,7 +300,7 @@ void MainWindow::setupPerformanceCharts()
     // Turnaround Time Chart
     turnaroundTimeChart = new QChart();
     turnaroundTimeChart->setTitle("Turnaround Time per Process");
-    turnaroundTimeChart->setAnimationOptions(QChart::SeriesAnimations);
+    setupBarChart(turnaroundTimeChart, QStringList() << "Turnaround Time");
     turnaroundTimeView = new QChartView(turnaroundTimeChart);
     turnaroundTimeView->setRenderHint(QPainter::Antialiasing);
     QVBoxLayout *turnaroundTimeLayout = new QVBoxLayout(ui->turnaroundTimeTab);
@@ -118,7 +309,7 @@ void MainWindow::setupPerformanceCharts()
     // Response Time Chart
     responseTimeChart = new QChart();
     responseTimeChart->setTitle("Response Time per Process");
-    responseTimeChart->setAnimationOptions(QChart::SeriesAnimations);
+    setupBarChart(responseTimeChart, QStringList() << "Response Time");
     responseTimeView = new QChartView(responseTimeChart);
     responseTimeView->setRenderHint(QPainter::Antialiasing);
     QVBoxLayout *responseTimeLayout = new QVBoxLayout(ui->responseTimeTab);
@@ -127,7 +318,7 @@ void MainWindow::setupPerformanceCharts()
     // Process Comparison Chart
     processComparisonChart = new QChart();
     processComparisonChart->setTitle("Process Time Metrics Comparison");
-    processComparisonChart->setAnimationOptions(QChart::SeriesAnimations);
+    setupBarChart(processComparisonChart, QStringList() << "Waiting Time" << "Response Time" << "Burst Time");
     processComparisonView = new QChartView(processComparisonChart);
     processComparisonView->setRenderHint(QPainter::Antialiasing);
     QVBoxLayout *processComparisonLayout = new QVBoxLayout(ui->processComparisonTab);
@@ -136,7 +327,7 @@ void MainWindow::setupPerformanceCharts()
     // Throughput Chart
     throughputChart = new QChart();
     throughputChart->setTitle("Throughput Over Time");
-    throughputChart->setAnimationOptions(QChart::SeriesAnimations);
+    setupLineChart(throughputChart, "Processes completed per tick");
     throughputView = new QChartView(throughputChart);
     throughputView->setRenderHint(QPainter::Antialiasing);
     QVBoxLayout *throughputLayout = new QVBoxLayout(ui->throughputTab);
@@ -145,7 +336,7 @@ void MainWindow::setupPerformanceCharts()
     // CPU Distribution Chart (Pie Chart)
     cpuDistributionChart = new QChart();
     cpuDistributionChart->setTitle("CPU Time Distribution");
-    cpuDistributionChart->setAnimationOptions(QChart::SeriesAnimations);
+    cpuDistributionChart->addSeries(new QPieSeries());
     cpuDistributionView = new QChartView(cpuDistributionChart);
     cpuDistributionView->setRenderHint(QPainter::Antialiasing);
     QVBoxLayout *cpuDistributionLayout = new QVBoxLayout(ui->pieChartTab);
@@ -155,12 +346,9 @@ void MainWindow::setupPerformanceCharts()
 bool MainWindow::validateProcessInput()
 {
     // Check if process ID is unique
-    int newId = ui->processIdSpinBox->value();
-    for (const Process &process : processes) {
-        if (process.id == newId) {
-            QMessageBox::warning(this, "Invalid Input", "Process ID must be unique.");
-            return false;
-        }
+    if (processIndex.contains(ui->processIdSpinBox->value())) {
+        QMessageBox::warning(this, "Invalid Input", "Process ID must be unique.");
+        return false;
     }
     return true;
 }
@@ -171,258 +359,350 @@ void MainWindow::on_addProcessButton_clicked()
         return;
     }
     
-    Process newProcess;
-    newProcess.id = ui->processIdSpinBox->value();
-    newProcess.arrivalTime = ui->arrivalTimeSpinBox->value();
-    newProcess.burstTime = ui->burstTimeSpinBox->value();
-    newProcess.priority = ui->prioritySpinBox->value();
-    newProcess.remainingTime = newProcess.burstTime;
-    newProcess.status = "Waiting";
-    newProcess.color = getRandomColor();
-    newProcess.completionTime = -1;
-    newProcess.turnaroundTime = -1;
-    newProcess.waitingTime = -1;
-    newProcess.responseTime = -1;
-    newProcess.startTime = -1;
-    
-    processes.append(newProcess);
-    processColors[newProcess.id] = newProcess.color;
+    ProcessStore &store = engine.processes();
+    processTableModel->beginStoreReset();
+    processIndex.insert(ui->processIdSpinBox->value(), store.size());
+    store.append(ui->processIdSpinBox->value(),
+                 ui->arrivalTimeSpinBox->value(),
+                 ui->burstTimeSpinBox->value(),
+                 ui->prioritySpinBox->value());
+    processTableModel->endStoreReset();
     
     // Auto-increment process ID
     ui->processIdSpinBox->setValue(ui->processIdSpinBox->value() + 1);
     
-    // Update the table
-    updateProcessTable();
-    
-    // Enable remove process button if there are processes
-    ui->removeProcessButton->setEnabled(!processes.isEmpty());
+    processesChanged();
 }
 
-QColor MainWindow::getRandomColor()
+void MainWindow::updateProcessTable()
 {
-    return QColor(
-        QRandomGenerator::global()->bounded(50, 200),
-        QRandomGenerator::global()->bounded(50, 200),
-        QRandomGenerator::global()->bounded(50, 200)
-    );
+    const ScopedPhaseTimer timer(profiler, ProfilePhase::ProcessTable);
+    processTableModel->refreshAll();
 }
 
-void MainWindow::updateProcessTable()
+// Called once after each edit to the process list, however many processes it touched
+void MainWindow::processesChanged()
 {
-    ui->processTableWidget->setRowCount(processes.size());
+    // A changed workload invalidates a simulation in progress, even one moved
+    // back to 0 on the timeline, which would otherwise resume the old workload
+    if (furthestTime > 0 || simulationRunning) {
+        resetSimulation();
+    } else {
+        updateProcessTable();
+    }
     
-    for (int i = 0; i < processes.size(); ++i) {
-        const Process &process = processes[i];
-        
-        ui->processTableWidget->setItem(i, 0, new QTableWidgetItem(QString::number(process.id)));
-        ui->processTableWidget->setItem(i, 1, new QTableWidgetItem(QString::number(process.arrivalTime)));
-        ui->processTableWidget->setItem(i, 2, new QTableWidgetItem(QString::number(process.burstTime)));
-        ui->processTableWidget->setItem(i, 3, new QTableWidgetItem(QString::number(process.priority)));
-        
-        if (process.startTime != -1) {
-            ui->processTableWidget->setItem(i, 4, new QTableWidgetItem(QString::number(process.startTime)));
-        } else {
-            ui->processTableWidget->setItem(i, 4, new QTableWidgetItem("-"));
-        }
-        
-        if (process.completionTime != -1) {
-            ui->processTableWidget->setItem(i, 5, new QTableWidgetItem(QString::number(process.completionTime)));
-            ui->processTableWidget->setItem(i, 6, new QTableWidgetItem(QString::number(process.turnaroundTime)));
-            ui->processTableWidget->setItem(i, 7, new QTableWidgetItem(QString::number(process.waitingTime)));
-            ui->processTableWidget->setItem(i, 8, new QTableWidgetItem(QString::number(process.responseTime)));
-        } else {
-            ui->processTableWidget->setItem(i, 5, new QTableWidgetItem("-"));
-            ui->processTableWidget->setItem(i, 6, new QTableWidgetItem("-"));
-            ui->processTableWidget->setItem(i, 7, new QTableWidgetItem("-"));
-            ui->processTableWidget->setItem(i, 8, new QTableWidgetItem("-"));
+    // Enable remove process button if there are processes
+    ui->removeProcessButton->setEnabled(!engine.processes().isEmpty());
+}
+
+// Selected rows in ascending order, read from the selection's ranges rather than row by row
+std::vector<int> MainWindow::selectedProcessRows() const
+{
+    const int rowCount = engine.processes().size();
+    std::vector<char> selected(rowCount, 0);
+    for (const QItemSelectionRange &range : ui->processTableView->selectionModel()->selection()) {
+        const int last = qMin(range.bottom(), rowCount - 1);
+        for (int row = qMax(range.top(), 0); row <= last; ++row) {
+            selected[row] = 1;
         }
-        
-        ui->processTableWidget->setItem(i, 9, new QTableWidgetItem(process.status));
-        
-        // Color the row based on status
-        for (int j = 0; j < ui->processTableWidget->columnCount(); ++j) {
-            QTableWidgetItem *item = ui->processTableWidget->item(i, j);
-            if (item) {
-                if (process.status == "Running") {
-                    item->setBackground(QBrush(Qt::green));
-                } else if (process.status == "Completed") {
-                    item->setBackground(QBrush(Qt::gray));
-                } else if (process.status == "Waiting") {
-                    item->setBackground(QBrush(Qt::white));
-                }
-            }
+    }
+    
+    std::vector<int> rows;
+    for (int row = 0; row < rowCount; ++row) {
+        if (selected[row]) {
+            rows.push_back(row);
         }
     }
+    return rows;
 }
 
 void MainWindow::on_removeProcessButton_clicked()
 {
-    QList<QTableWidgetItem*> selectedItems = ui->processTableWidget->selectedItems();
-    if (selectedItems.isEmpty()) {
-        QMessageBox::warning(this, "No Selection", "Please select a process to remove.");
+    on_actionRemoveSelected_triggered();
+}
+
+void MainWindow::on_actionRemoveSelected_triggered()
+{
+    const std::vector<int> rows = selectedProcessRows();
+    if (rows.empty()) {
+        QMessageBox::warning(this, "No Selection", "Please select the processes to remove.");
         return;
     }
     
-    int row = selectedItems.first()->row();
-    if (row >= 0 && row < processes.size()) {
-        processes.removeAt(row);
-        updateProcessTable();
-        
-        // Disable remove button if no processes left
-        ui->removeProcessButton->setEnabled(!processes.isEmpty());
+    // Every selected row goes in one pass over the store
+    std::vector<char> marked(engine.processes().size(), 0);
+    for (int row : rows) {
+        marked[row] = 1;
+    }
+    ui->processTableView->clearSelection();
+    processTableModel->beginStoreReset();
+    removeProcesses(engine.processes(), processIndex, marked);
+    processTableModel->endStoreReset();
+    processesChanged();
+}
+
+void MainWindow::on_actionRemoveIdRange_triggered()
+{
+    if (engine.processes().isEmpty()) {
+        QMessageBox::warning(this, "No Processes", "There are no processes to remove.");
+        return;
+    }
+    
+    bool ok = false;
+    const QString text = QInputDialog::getText(this, "Remove ID Range", "Remove processes with IDs from-to (e.g. 100-200):",
+                                               QLineEdit::Normal, QString(), &ok).trimmed();
+    if (!ok || text.isEmpty()) {
+        return;
+    }
+    
+    // A single ID removes just that process
+    const QStringList bounds = text.split('-');
+    bool firstOk = false;
+    bool lastOk = bounds.size() == 1;
+    const int first = bounds.first().trimmed().toInt(&firstOk);
+    const int last = bounds.size() == 2 ? bounds.last().trimmed().toInt(&lastOk) : first;
+    if (bounds.size() > 2 || !firstOk || !lastOk || first > last) {
+        QMessageBox::warning(this, "Invalid Input", "Enter an ID range as from-to, e.g. 100-200.");
+        return;
+    }
+    
+    processTableModel->beginStoreReset();
+    const int removed = removeProcessesIf(engine.processes(), processIndex, [first, last](const ProcessStore &store, int slot) {
+        return store.id[slot] >= first && store.id[slot] <= last;
+    });
+    processTableModel->endStoreReset();
+    if (removed == 0) {
+        QMessageBox::information(this, "Remove ID Range", "No process has an ID in that range.");
+        return;
+    }
+    ui->processTableView->clearSelection();
+    processesChanged();
+}
+
+void MainWindow::on_actionEditSelected_triggered()
+{
+    const std::vector<int> rows = selectedProcessRows();
+    if (rows.empty()) {
+        QMessageBox::warning(this, "No Selection", "Please select the processes to edit.");
+        return;
+    }
+    
+    bool ok = false;
+    const QString text = QInputDialog::getText(this, "Edit Selected",
+                                               QString("New values for %1 processes, e.g. arrival=0;burst=5;priority=2\n"
+                                                       "(fields left out keep their values):").arg(rows.size()),
+                                               QLineEdit::Normal, QString(), &ok).trimmed();
+    if (!ok || text.isEmpty()) {
+        return;
+    }
+    
+    // Same key=value syntax as the generator's command-line specs
+    ProcessEdit edit;
+    for (const QString &field : text.split(';')) {
+        if (field.trimmed().isEmpty()) {
+            continue;
+        }
+        const QStringList pair = field.split('=');
+        bool valueOk = false;
+        const int value = pair.size() == 2 ? pair.last().trimmed().toInt(&valueOk) : 0;
+        const QString key = pair.first().trimmed();
+        if (!valueOk || value < 0) {
+            QMessageBox::warning(this, "Invalid Input", QString("Invalid field \"%1\".").arg(field.trimmed()));
+            return;
+        }
+        if (key == "arrival") {
+            edit.arrivalTime = value;
+        } else if (key == "burst" && ProcessStore::isValidBurstTime(value)) {
+            edit.burstTime = value;
+        } else if (key == "priority") {
+            edit.priority = value;
+        } else {
+            QMessageBox::warning(this, "Invalid Input", QString("Invalid field \"%1\".").arg(field.trimmed()));
+            return;
+        }
     }
+    
+    editProcesses(engine.processes(), rows, edit);
+    processesChanged();
 }
 
 void MainWindow::on_clearAllButton_clicked()
 {
-    processes.clear();
-    updateProcessTable();
+    processTableModel->beginStoreReset();
+    engine.processes().clear();
+    processIndex.clear();
+    processTableModel->endStoreReset();
     resetSimulation();
     ui->removeProcessButton->setEnabled(false);
 }
 
-void MainWindow::on_importButton_clicked()
+// Asks for a workload file and loads it into imported on worker threads; false if
+// the user cancelled or the file could not be read (which is reported here)
+bool MainWindow::loadProcessFile(const QString &title, ProcessStore &imported, CsvParseResult &parseResult)
 {
-    QString fileName = QFileDialog::getOpenFileName(this, "Import Processes", "", "CSV Files (*.csv);;Text Files (*.txt);;All Files (*)");
+    QString fileName = QFileDialog::getOpenFileName(this, title, "", "CSV Files (*.csv);;Binary Workloads (*.simbin);;Text Files (*.txt);;All Files (*)");
     if (fileName.isEmpty()) {
-        return;
+        return false;
     }
     
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QMessageBox::critical(this, "Error", "Could not open file for reading.");
-        return;
+    // Parse on worker threads; the window keeps repainting while we wait
+    QString errorMessage;
+    CsvParseProgress progress;
+    const qint64 fileSize = QFileInfo(fileName).size();
+    
+    QProgressDialog progressDialog("Importing processes...", "Cancel", 0, 1000, this);
+    progressDialog.setWindowModality(Qt::WindowModal);
+    progressDialog.setMinimumDuration(300);
+    connect(&progressDialog, &QProgressDialog::canceled, this, [&progress]() {
+        progress.cancelRequested = true;
+    });
+    
+    QTimer progressTimer;
+    connect(&progressTimer, &QTimer::timeout, this, [&]() {
+        if (fileSize > 0) {
+            progressDialog.setValue(static_cast<int>(qMin<qint64>(progress.bytesParsed * 1000 / fileSize, 999)));
+        }
+    });
+    progressTimer.start(50);
+    
+    QFutureWatcher<bool> watcher;
+    QEventLoop loop;
+    connect(&watcher, &QFutureWatcher<bool>::finished, &loop, &QEventLoop::quit);
+    watcher.setFuture(QtConcurrent::run([&]() {
+        if (isBinaryWorkloadFile(fileName)) {
+            return loadWorkloadBinary(fileName, imported, &errorMessage);
+        }
+        return loadWorkloadCsv(fileName, imported, &errorMessage, &parseResult, &progress);
+    }));
+    if (!watcher.isFinished()) {
+        loop.exec();
     }
+    progressTimer.stop();
+    progressDialog.reset();
     
-    QTextStream in(&file);
-    processes.clear();
-    
-    // Skip header line if it exists
-    QString line = in.readLine();
-    if (!line.startsWith(QRegExp("\\d+"))) {
-        // First line was a header, read the next line
-        line = in.readLine();
-    }
-    
-    while (!line.isNull()) {
-        QStringList fields = line.split(',');
-        if (fields.size() >= 4) {
-            Process process;
-            process.id = fields[0].toInt();
-            process.arrivalTime = fields[1].toInt();
-            process.burstTime = fields[2].toInt();
-            process.priority = fields[3].toInt();
-            process.remainingTime = process.burstTime;
-            process.status = "Waiting";
-            process.color = getRandomColor();
-            process.completionTime = -1;
-            process.turnaroundTime = -1;
-            process.waitingTime = -1;
-            process.responseTime = -1;
-            process.startTime = -1;
-            
-            processes.append(process);
-            processColors[process.id] = process.color;
+    if (!watcher.result()) {
+        if (!parseResult.cancelled) {
+            QMessageBox::critical(this, "Error", errorMessage);
         }
-        line = in.readLine();
+        return false;
+    }
+    return true;
+}
+
+void MainWindow::on_importButton_clicked()
+{
+    ProcessStore imported;
+    CsvParseResult parseResult;
+    if (!loadProcessFile("Import Processes", imported, parseResult)) {
+        return;
     }
     
-    file.close();
-    updateProcessTable();
-    ui->removeProcessButton->setEnabled(!processes.isEmpty());
+    ProcessStore &store = engine.processes();
+    processTableModel->beginStoreReset();
+    store = std::move(imported);
+    processIndex.rebuild(store);
+    processTableModel->endStoreReset();
+    resetSimulation();
+    ui->removeProcessButton->setEnabled(!store.isEmpty());
     
-    // Find the next available process ID
-    int maxId = 0;
-    for (const Process &process : processes) {
-        maxId = qMax(maxId, process.id);
+    // Next available process ID
+    ui->processIdSpinBox->setValue(processIndex.maxId() + 1);
+    
+    QString message = QString("Imported %1 processes.").arg(store.size());
+    if (parseResult.errorCount > 0) {
+        message += QString("\n\n%1 malformed rows were skipped:\n%2").arg(parseResult.errorCount).arg(describeCsvErrors(parseResult));
+        QMessageBox::warning(this, "Import Completed With Errors", message);
+    } else {
+        QMessageBox::information(this, "Import Successful", message);
+    }
+}
+
+void MainWindow::on_actionAppendProcesses_triggered()
+{
+    ProcessStore imported;
+    CsvParseResult parseResult;
+    if (!loadProcessFile("Append Processes", imported, parseResult)) {
+        return;
     }
-    ui->processIdSpinBox->setValue(maxId + 1);
     
-    QMessageBox::information(this, "Import Successful", QString("Imported %1 processes.").arg(processes.size()));
+    // Adds the whole file at once, checking each ID against the index
+    processTableModel->beginStoreReset();
+    const int skipped = appendProcesses(engine.processes(), processIndex, imported);
+    processTableModel->endStoreReset();
+    processesChanged();
+    ui->processIdSpinBox->setValue(processIndex.maxId() + 1);
+    
+    QString message = QString("Appended %1 processes.").arg(imported.size() - skipped);
+    if (skipped > 0) {
+        message += QString("\n\n%1 processes were skipped because their IDs are already in the list.").arg(skipped);
+    }
+    if (parseResult.errorCount > 0) {
+        message += QString("\n\n%1 malformed rows were skipped:\n%2").arg(parseResult.errorCount).arg(describeCsvErrors(parseResult));
+    }
+    if (skipped > 0 || parseResult.errorCount > 0) {
+        QMessageBox::warning(this, "Append Completed With Errors", message);
+    } else {
+        QMessageBox::information(this, "Append Successful", message);
+    }
 }
 
 void MainWindow::on_exportButton_clicked()
 {
-    if (processes.isEmpty()) {
+    if (engine.processes().isEmpty()) {
         QMessageBox::warning(this, "No Data", "There are no processes to export.");
         return;
     }
     
-    QString fileName = QFileDialog::getSaveFileName(this, "Export Results", "", "CSV Files (*.csv);;Text Files (*.txt);;All Files (*)");
+    QString fileName = QFileDialog::getSaveFileName(this, "Export Results", "", "CSV Files (*.csv);;Binary Results (*.simbin);;Text Files (*.txt);;All Files (*)");
     if (fileName.isEmpty()) {
         return;
     }
     
-    QFile file(fileName);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QMessageBox::critical(this, "Error", "Could not open file for writing.");
-        return;
-    }
-    
-    QTextStream out(&file);
-    
-    // Write header
-    out << "Process ID,Arrival Time,Burst Time,Priority,Start Time,Completion Time,Turnaround Time,Waiting Time,Response Time,Status\n";
-    
-    // Write data
-    for (const Process &process : processes) {
-        out << process.id << ","
-            << process.arrivalTime << ","
-            << process.burstTime << ","
-            << process.priority << ",";
-        
-        if (process.startTime != -1) {
-            out << process.startTime;
-        }
-        out << ",";
-        
-        if (process.completionTime != -1) {
-            out << process.completionTime << ","
-                << process.turnaroundTime << ","
-                << process.waitingTime << ","
-                << process.responseTime;
-        } else {
-            out << ",,,";
-        }
-        
-        out << "," << process.status << "\n";
-    }
+    // Export a snapshot in the background so the simulation and UI keep going
+    auto snapshot = std::make_shared<ProcessStore>(engine.processes());
+    auto progress = std::make_shared<ExportProgress>();
+    const SimTime exportTime = currentTime;
+    const bool binary = fileName.endsWith(".simbin", Qt::CaseInsensitive);
     
-    // Write summary statistics
-    out << "\nSummary Statistics\n";
-    out << "Total Processes," << processes.size() << "\n";
+    QProgressDialog *progressDialog = new QProgressDialog("Exporting results...", "Cancel", 0, snapshot->size(), this);
+    progressDialog->setMinimumDuration(300);
+    connect(progressDialog, &QProgressDialog::canceled, this, [progress]() {
+        progress->cancelRequested = true;
+    });
     
-    if (currentTime > 0) {
-        int completedProcesses = 0;
-        int totalTurnaroundTime = 0;
-        int totalWaitingTime = 0;
-        int totalResponseTime = 0;
+    QFutureWatcher<QString> *watcher = new QFutureWatcher<QString>(this);
+    QTimer *progressTimer = new QTimer(watcher);
+    connect(progressTimer, &QTimer::timeout, progressDialog, [progressDialog, progress]() {
+        progressDialog->setValue(qMin(progress->rowsWritten.load(), progressDialog->maximum() - 1));
+    });
+    connect(watcher, &QFutureWatcher<QString>::finished, this, [this, watcher, progressDialog, progress]() {
+        watcher->deleteLater();
+        progressDialog->deleteLater();
         
-        for (const Process &process : processes) {
-            if (process.completionTime != -1) {
-                completedProcesses++;
-                totalTurnaroundTime += process.turnaroundTime;
-                totalWaitingTime += process.waitingTime;
-                totalResponseTime += process.responseTime;
-            }
+        const QString errorMessage = watcher->result();
+        if (progress->cancelRequested) {
+            return;
         }
-        
-        if (completedProcesses > 0) {
-            out << "Completed Processes," << completedProcesses << "\n";
-            out << "Average Turnaround Time," << QString::number(static_cast<double>(totalTurnaroundTime) / completedProcesses, 'f', 2) << "\n";
-            out << "Average Waiting Time," << QString::number(static_cast<double>(totalWaitingTime) / completedProcesses, 'f', 2) << "\n";
-            out << "Average Response Time," << QString::number(static_cast<double>(totalResponseTime) / completedProcesses, 'f', 2) << "\n";
-            out << "Throughput," << QString::number(static_cast<double>(completedProcesses) / currentTime, 'f', 2) << " processes/unit time\n";
+        if (!errorMessage.isEmpty()) {
+            QMessageBox::critical(this, "Error", errorMessage);
+            return;
         }
-    }
+        QMessageBox::information(this, "Export Successful", "Results exported successfully.");
+    });
     
-    file.close();
-    QMessageBox::information(this, "Export Successful", "Results exported successfully.");
+    watcher->setFuture(QtConcurrent::run([fileName, snapshot, exportTime, binary, progress]() {
+        QString errorMessage;
+        const bool written = binary
+            ? writeWorkloadBinary(fileName, *snapshot, exportTime, true, &errorMessage, progress.get())
+            : writeResultsCsv(fileName, *snapshot, exportTime, &errorMessage, progress.get());
+        return written ? QString() : errorMessage;
+    }));
+    progressTimer->start(50);
 }
 
 void MainWindow::on_startSimulationButton_clicked()
 {
-    if (processes.isEmpty()) {
+    if (engine.processes().isEmpty()) {
         QMessageBox::warning(this, "No Processes", "Please add processes before starting the simulation.");
         return;
     }
@@ -433,6 +713,8 @@ void MainWindow::on_startSimulationButton_clicked()
     } else {
         pauseSimulation();
         ui->startSimulationButton->setText("Resume");
+        // Show the ticks the worker got through before it stopped
+        simulationStep();
     }
 }
 
@@ -445,34 +727,84 @@ void MainWindow::on_speedSlider_valueChanged(int value)
 {
     ui->speedValueLabel->setText(QString("%1 ms").arg(value));
     if (simulationRunning) {
-        simulationTimer->setInterval(value);
+        simulationWorker.setInterval(value);
     }
 }
 
-void MainWindow::on_processTableWidget_cellClicked(int row, int column)
+void MainWindow::on_maxSpeedCheckBox_toggled(bool checked)
 {
-    if (row >= 0 && row < processes.size()) {
+    // At max speed the slider has no say; the display still refreshes at its own rate
+    ui->speedSlider->setEnabled(!checked);
+    simulationWorker.setFastForward(checked);
+}
+
+void MainWindow::on_policyComboBox_currentIndexChanged(int index)
+{
+    const SchedulingPolicy policy = static_cast<SchedulingPolicy>(ui->policyComboBox->itemData(index).toInt());
+    ui->quantumSpinBox->setEnabled(policy == SchedulingPolicy::RoundRobin);
+    engine.setPolicy(policy, ui->quantumSpinBox->value());
+    
+    // Results of the previous policy no longer apply
+    resetSimulation();
+}
+
+void MainWindow::on_quantumSpinBox_valueChanged(int value)
+{
+    engine.setPolicy(engine.policy(), value);
+    if (engine.policy() == SchedulingPolicy::RoundRobin) {
+        resetSimulation();
+    }
+}
+
+void MainWindow::on_coresSpinBox_valueChanged(int value)
+{
+    ui->workStealingCheckBox->setEnabled(value > 1);
+    engine.setCoreCount(value);
+    resetSimulation();
+}
+
+void MainWindow::on_workStealingCheckBox_toggled(bool checked)
+{
+    engine.setWorkStealing(checked);
+    resetSimulation();
+}
+
+void MainWindow::on_timelineSlider_valueChanged(int value)
+{
+    // The worker restores the nearest checkpoint and simulates the rest, then publishes that instant
+    pauseSimulation();
+    simulationWorker.seek(timelineTime(value, furthestTime));
+    simulationStep();
+    if (!engine.isFinished()) {
+        ui->startSimulationButton->setText("Resume");
+    }
+}
+
+void MainWindow::on_processTableView_clicked(const QModelIndex &index)
+{
+    int row = index.row();
+    if (row >= 0 && row < engine.processes().size()) {
         updateProcessDetails(row);
     }
 }
 
-void MainWindow::updateProcessDetails(int processIndex)
+void MainWindow::updateProcessDetails(int row)
 {
-    if (processIndex < 0 || processIndex >= processes.size()) {
+    const ScopedPhaseTimer timer(profiler, ProfilePhase::Details);
+    const ProcessStore &store = engine.processes();
+    if (row < 0 || row >= store.size()) {
         return;
     }
     
-    const Process &process = processes[processIndex];
-    
-    ui->detailsProcessIdLabel->setText(QString::number(process.id));
-    ui->detailsArrivalTimeLabel->setText(QString::number(process.arrivalTime));
-    ui->detailsBurstTimeLabel->setText(QString::number(process.burstTime));
+    ui->detailsProcessIdLabel->setText(QString::number(store.id[row]));
+    ui->detailsArrivalTimeLabel->setText(QString::number(store.arrivalTime[row]));
+    ui->detailsBurstTimeLabel->setText(QString::number(store.burstTime[row]));
     
-    if (process.completionTime != -1) {
-        ui->detailsCompletionTimeLabel->setText(QString::number(process.completionTime));
-        ui->detailsTurnaroundTimeLabel->setText(QString::number(process.turnaroundTime));
-        ui->detailsWaitingTimeLabel->setText(QString::number(process.waitingTime));
-        ui->detailsResponseTimeLabel->setText(QString::number(process.responseTime));
+    if (store.completionTime[row] != -1) {
+        ui->detailsCompletionTimeLabel->setText(QString::number(store.completionTime[row]));
+        ui->detailsTurnaroundTimeLabel->setText(QString::number(store.turnaroundTime(row)));
+        ui->detailsWaitingTimeLabel->setText(QString::number(store.waitingTime(row)));
+        ui->detailsResponseTimeLabel->setText(QString::number(store.responseTime(row)));
     } else {
         ui->detailsCompletionTimeLabel->setText("-");
         ui->detailsTurnaroundTimeLabel->setText("-");
@@ -480,51 +812,46 @@ void MainWindow::updateProcessDetails(int processIndex)
         ui->detailsResponseTimeLabel->setText("-");
     }
     
-    ui->detailsStatusLabel->setText(process.status);
+    const ProcessStatus status = store.status[row];
+    ui->detailsStatusLabel->setText(processStatusName(status));
     
-    if (process.status == "Running") {
-        int progress = ((process.burstTime - process.remainingTime) * 100) / process.burstTime;
+    if (status == ProcessStatus::Running) {
+        const int burstTime = store.burstTime[row];
+        int progress = static_cast<int>(((burstTime - engine.remainingTime(row)) * 100) / burstTime);
         ui->detailsProgressBar->setValue(progress);
-    } else if (process.status == "Completed") {
+    } else if (status == ProcessStatus::Completed) {
         ui->detailsProgressBar->setValue(100);
     } else {
         ui->detailsProgressBar->setValue(0);
     }
 }
 
-void MainWindow::sortProcessesByArrivalTime()
-{
-    std::sort(processes.begin(), processes.end(), [](const Process &a, const Process &b) {
-        return a.arrivalTime < b.arrivalTime;
-    });
-}
-
 void MainWindow::resetSimulation()
 {
     pauseSimulation();
     
     currentTime = 0;
+    furthestTime = 0;
     currentProcessIndex = -1;
     
     // Reset process stats
-    for (int i = 0; i < processes.size(); ++i) {
-        processes[i].remainingTime = processes[i].burstTime;
-        processes[i].status = "Waiting";
-        processes[i].completionTime = -1;
-        processes[i].turnaroundTime = -1;
-        processes[i].waitingTime = -1;
-        processes[i].responseTime = -1;
-        processes[i].startTime = -1;
-    }
+    engine.reset();
     
     // Update UI elements
     ui->currentTimeLabel->setText("Current Time: 0");
-    ui->progressLabel->setText(QString("Progress: 0/%1 processes completed").arg(processes.size()));
+    {
+        const QSignalBlocker blocker(ui->timelineSlider);
+        ui->timelineSlider->setRange(0, 0);
+    }
+    ui->progressLabel->setText(QString("Progress: 0/%1 processes completed").arg(engine.processes().size()));
     ui->cpuUtilizationBar->setValue(0);
     ui->avgTurnaroundTimeLabel->setText("Average Turnaround Time: 0.00");
     ui->avgWaitingTimeLabel->setText("Average Waiting Time: 0.00");
     ui->avgResponseTimeLabel->setText("Average Response Time: 0.00");
     ui->throughputLabel->setText("Throughput: 0.00 processes/unit time");
+    ui->turnaroundPercentilesLabel->setText(percentileText("Turnaround", engine.turnaroundHistogram()));
+    ui->waitingPercentilesLabel->setText(percentileText("Waiting", engine.waitingHistogram()));
+    ui->responsePercentilesLabel->setText(percentileText("Response", engine.responseHistogram()));
     
     updateProcessTable();
     setupGanttChart();
@@ -534,19 +861,26 @@ void MainWindow::resetSimulation()
 
 void MainWindow::initializeSimulation()
 {
+    // The engine dispatches in arrival order itself, so the table keeps its order
     resetSimulation();
-    sortProcessesByArrivalTime();
-    updateProcessTable();
 }
 
-void MainWindow::startSimulation()
+void MainWindow::startSimulation(bool toEnd)
 {
-    if (currentTime == 0) {
+    // A finished run starts over; one moved back to 0 on the timeline resumes from there
+    if (furthestTime == 0 || engine.isFinished()) {
         initializeSimulation();
+        // The worker simulates its own copy; engine replays what it publishes
+        simulationWorker.load(engine);
     }
     
     simulationRunning = true;
-    simulationTimer->start(ui->speedSlider->value());
+    if (toEnd) {
+        simulationWorker.runToEnd();
+    } else {
+        simulationWorker.start(ui->speedSlider->value());
+    }
+    simulationTimer->start(DisplayRefreshInterval);
     ui->resetButton->setEnabled(true);
 }
 
@@ -554,346 +888,235 @@ void MainWindow::pauseSimulation()
 {
     simulationRunning = false;
     simulationTimer->stop();
+    simulationWorker.stop();
 }
 
 void MainWindow::simulationStep()
 {
-    // Increment current time
-    currentTime++;
-    ui->currentTimeLabel->setText(QString("Current Time: %1").arg(currentTime));
-    
-    // Check if any process is currently running
-    bool hasRunningProcess = false;
+    // Catch up with every frame the worker published since the last refresh
     int runningProcessIndex = -1;
-    
-    for (int i = 0; i < processes.size(); ++i) {
-        if (processes[i].status == "Running") {
-            hasRunningProcess = true;
-            runningProcessIndex = i;
-            break;
+    bool updated = false;
+    while (SimulationFrame *frame = simulationWorker.takeFrame()) {
+        {
+            const ScopedPhaseTimer timer(profiler, ProfilePhase::ApplyFrames);
+            engine.applyFrame(*frame);
+            simulationWorker.releaseFrame(frame);
         }
-    }
-    
-    // If no process is running, find the next process to run (FCFS algorithm)
-    if (!hasRunningProcess) {
-        for (int i = 0; i < processes.size(); ++i) {
-            if (processes[i].status == "Waiting" && processes[i].arrivalTime <= currentTime) {
-                processes[i].status = "Running";
-                processes[i].startTime = currentTime;
-                processes[i].responseTime = currentTime - processes[i].arrivalTime;
-                runningProcessIndex = i;
-                hasRunningProcess = true;
-                break;
-            }
+        {
+            const ScopedPhaseTimer timer(profiler, ProfilePhase::ProcessTable);
+            processTableModel->refreshRows(engine.changedIndices());
+        }
+        if (!engine.changedIndices().empty()) {
+            runningProcessIndex = engine.changedIndices().back();
         }
+        updated = true;
+    }
+    if (!updated) {
+        return;
+    }
+    if (profiler.isEnabled()) {
+        profiler.record(ProfilePhase::Simulate, simulationWorker.takeWorkTime());
+    }
+    if (engine.runningIndex() != -1) {
+        runningProcessIndex = engine.runningIndex();
     }
     
-    // Process the running process
-    if (hasRunningProcess) {
-        processes[runningProcessIndex].remainingTime--;
-        
-        // Check if process has completed
-        if (processes[runningProcessIndex].remainingTime == 0) {
-            processes[runningProcessIndex].status = "Completed";
-            processes[runningProcessIndex].completionTime = currentTime;
-            processes[runningProcessIndex].turnaroundTime = processes[runningProcessIndex].completionTime - processes[runningProcessIndex].arrivalTime;
-            processes[runningProcessIndex].waitingTime = processes[runningProcessIndex].turnaroundTime - processes[runningProcessIndex].burstTime;
-        }
+    currentTime = engine.currentTime();
+    ui->currentTimeLabel->setText(QString("Current Time: %1").arg(currentTime));
+    {
+        const QSignalBlocker blocker(ui->timelineSlider);
+        furthestTime = std::max(furthestTime, currentTime);
+        ui->timelineSlider->setMaximum(timelinePosition(furthestTime, furthestTime));
+        ui->timelineSlider->setValue(timelinePosition(currentTime, furthestTime));
     }
     
     // Update UI
-    updateProcessTable();
     if (runningProcessIndex != -1) {
         updateProcessDetails(runningProcessIndex);
     }
     updateGanttChart();
     updateSimulationStats();
     
-    // Check if all processes are completed
-    bool allCompleted = true;
-    for (const Process &process : processes) {
-        if (process.status != "Completed") {
-            allCompleted = false;
-            break;
-        }
-    }
-    
-    if (allCompleted) {
+    if (engine.isFinished()) {
         finishSimulation();
     }
 }
 
 void MainWindow::finishSimulation()
 {
+    // Seeking to the end is not worth a message
+    const bool announce = simulationRunning;
     pauseSimulation();
     ui->startSimulationButton->setText("Restart");
     updatePerformanceCharts();
-    QMessageBox::information(this, "Simulation Complete", "All processes have completed.");
+    if (announce) {
+        QMessageBox::information(this, "Simulation Complete", "All processes have completed.");
+    }
 }
 
 void MainWindow::updateGanttChart()
 {
-    // Clear existing chart
-    ganttChartScene->clear();
-    
-    int timeScale = 20; // Pixels per time unit
-    int rowHeight = 30; // Height of each process row
-    int startY = 10;
-    int timelineY = startY + processes.size() * rowHeight + 20;
-    
-    // Draw time axis
-    ganttChartScene->addLine(0, timelineY, currentTime * timeScale, timelineY, QPen(Qt::black, 2));
-    
-    // Draw time markers
-    for (int t = 0; t <= currentTime; t += 5) {
-        ganttChartScene->addLine(t * timeScale, timelineY - 5, t * timeScale, timelineY + 5, QPen(Qt::black, 1));
-        QGraphicsTextItem *timeText = ganttChartScene->addText(QString::number(t));
-        timeText->setPos(t * timeScale - 5, timelineY + 5);
-    }
-    
-    // Draw process labels and execution blocks
-    for (int i = 0; i < processes.size(); ++i) {
-        const Process &process = processes[i];
-        int yPos = startY + i * rowHeight;
-        
-        // Process label
-        QGraphicsTextItem *processText = ganttChartScene->addText(QString("P%1").arg(process.id));
-        processText->setPos(-30, yPos);
-        
-        // Draw execution blocks
-        if (process.startTime != -1) {
-            int xStart = process.startTime * timeScale;
-            int width;
-            
-            if (process.status == "Completed") {
-                width = (process.completionTime - process.startTime) * timeScale;
-            } else {
-                width = (currentTime - process.startTime) * timeScale;
-            }
-            QGraphicsRectItem *rectItem = ganttChartScene->addRect(xStart, yPos, width, rowHeight - 5, QPen(Qt::black), QBrush(process.color));
-            
-            // Add process ID text on the rectangle
-            QGraphicsTextItem *idText = ganttChartScene->addText(QString("P%1").arg(process.id));
-            idText->setDefaultTextColor(Qt::white);
-            idText->setPos(xStart + 5, yPos + 2);
-            
-            // Add start and end time markers
-            QGraphicsTextItem *startText = ganttChartScene->addText(QString::number(process.startTime));
-            startText->setPos(xStart, yPos + rowHeight);
-            
-            if (process.status == "Completed") {
-                QGraphicsTextItem *endText = ganttChartScene->addText(QString::number(process.completionTime));
-                endText->setPos(xStart + width - 10, yPos + rowHeight);
-            }
-        }
-    }
-    
-    // Adjust scene size
-    ganttChartScene->setSceneRect(ganttChartScene->itemsBoundingRect().adjusted(-50, -10, 50, 50));
+    const ScopedPhaseTimer timer(profiler, ProfilePhase::GanttChart);
+    // The view paints only what is visible straight from the engine's segments
+    ui->ganttChartView->refresh();
 }
 
 void MainWindow::updateSimulationStats()
 {
-    int completedProcesses = 0;
-    int totalTurnaroundTime = 0;
-    int totalWaitingTime = 0;
-    int totalResponseTime = 0;
-    int totalBurstTime = 0;
-    
-    for (const Process &process : processes) {
-        totalBurstTime += process.burstTime;
-        if (process.status == "Completed") {
-            completedProcesses++;
-            totalTurnaroundTime += process.turnaroundTime;
-            totalWaitingTime += process.waitingTime;
-            totalResponseTime += process.responseTime;
-        }
-    }
+    const ScopedPhaseTimer timer(profiler, ProfilePhase::Stats);
+    // Every figure comes from counters the engine maintains, so this is O(1)
+    const int completedProcesses = engine.completedCount();
     
     // Update progress label
-    ui->progressLabel->setText(QString("Progress: %1/%2 processes completed").arg(completedProcesses).arg(processes.size()));
-    
-    // Calculate CPU utilization
-    int idleTime = 0;
-    for (int t = 0; t < currentTime; ++t) {
-        bool busy = false;
-        for (const Process &process : processes) {
-            if (process.startTime <= t && (process.status == "Running" || (process.status == "Completed" && process.completionTime > t))) {
-                busy = true;
-                break;
-            }
-        }
-        if (!busy) {
-            idleTime++;
-        }
-    }
+    ui->progressLabel->setText(QString("Progress: %1/%2 processes completed").arg(completedProcesses).arg(engine.processes().size()));
     
-    int cpuUtilization = currentTime > 0 ? (currentTime - idleTime) * 100 / currentTime : 0;
+    // Calculate CPU utilization over all cores; the Gantt lane labels show each core's share
+    const SimTime capacity = currentTime * engine.coreCount();
+    int cpuUtilization = capacity > 0 ? static_cast<int>(engine.busyTime() * 100 / capacity) : 0;
     ui->cpuUtilizationBar->setValue(cpuUtilization);
     
     // Update average metrics
-    double avgTurnaroundTime = completedProcesses > 0 ? static_cast<double>(totalTurnaroundTime) / completedProcesses : 0.0;
-    double avgWaitingTime = completedProcesses > 0 ? static_cast<double>(totalWaitingTime) / completedProcesses : 0.0;
-    double avgResponseTime = completedProcesses > 0 ? static_cast<double>(totalResponseTime) / completedProcesses : 0.0;
+    double avgTurnaroundTime = completedProcesses > 0 ? static_cast<double>(engine.totalTurnaroundTime()) / completedProcesses : 0.0;
+    double avgWaitingTime = completedProcesses > 0 ? static_cast<double>(engine.totalWaitingTime()) / completedProcesses : 0.0;
+    double avgResponseTime = completedProcesses > 0 ? static_cast<double>(engine.totalResponseTime()) / completedProcesses : 0.0;
     double throughput = currentTime > 0 ? static_cast<double>(completedProcesses) / currentTime : 0.0;
     
     ui->avgTurnaroundTimeLabel->setText(QString("Average Turnaround Time: %1").arg(avgTurnaroundTime, 0, 'f', 2));
     ui->avgWaitingTimeLabel->setText(QString("Average Waiting Time: %1").arg(avgWaitingTime, 0, 'f', 2));
     ui->avgResponseTimeLabel->setText(QString("Average Response Time: %1").arg(avgResponseTime, 0, 'f', 2));
     ui->throughputLabel->setText(QString("Throughput: %1 processes/unit time").arg(throughput, 0, 'f', 2));
+    
+    // Tail latencies from the engine's fixed-size histograms, one bucket walk each
+    ui->turnaroundPercentilesLabel->setText(percentileText("Turnaround", engine.turnaroundHistogram()));
+    ui->waitingPercentilesLabel->setText(percentileText("Waiting", engine.waitingHistogram()));
+    ui->responsePercentilesLabel->setText(percentileText("Response", engine.responseHistogram()));
 }
 
 void MainWindow::updatePerformanceCharts()
 {
-    // Clear all charts
-    cpuUtilizationChart->removeAllSeries();
-    waitingTimeChart->removeAllSeries();
-    turnaroundTimeChart->removeAllSeries();
-    responseTimeChart->removeAllSeries();
-    processComparisonChart->removeAllSeries();
-    throughputChart->removeAllSeries();
-    cpuDistributionChart->removeAllSeries();
-    
-    // Only update charts if there are completed processes
-    bool hasCompletedProcesses = false;
-    for (const Process &process : processes) {
-        if (process.status == "Completed") {
-            hasCompletedProcesses = true;
-            break;
+    const ScopedPhaseTimer timer(profiler, ProfilePhase::Charts);
+    const ProcessStore &store = engine.processes();
+    // The series and axes are created once in setupPerformanceCharts() and updated in place
+    
+    // CPU Utilization and Throughput over time, from the engine's fixed-size history
+    const SimTime interval = engine.historyInterval();
+    const std::vector<SimTime> &busy = engine.busyHistory();
+    const std::vector<SimTime> &completions = engine.completionHistory();
+    std::vector<SeriesPoint> utilizationPoints;
+    std::vector<SeriesPoint> throughputPoints;
+    utilizationPoints.reserve(busy.size());
+    throughputPoints.reserve(completions.size());
+    double maxThroughput = 0.0;
+    for (std::size_t bucket = 0; bucket < busy.size(); ++bucket) {
+        // The last window is cut short at the current time; busy time is counted up to it, completions at it
+        const SimTime start = static_cast<SimTime>(bucket) * interval;
+        const SimTime busySpan = std::min<SimTime>(start + interval, currentTime) - start;
+        const SimTime completionSpan = std::min<SimTime>(start + interval, currentTime + 1) - start;
+        if (busySpan > 0) {
+            utilizationPoints.push_back({ static_cast<double>(start),
+                                          100.0 * busy[bucket] / (static_cast<double>(busySpan) * engine.coreCount()) });
+        }
+        if (completionSpan > 0) {
+            const double throughput = static_cast<double>(completions[bucket]) / completionSpan;
+            throughputPoints.push_back({ static_cast<double>(start), throughput });
+            maxThroughput = std::max(maxThroughput, throughput);
         }
     }
-    
-    if (!hasCompletedProcesses) {
-        return;
+    showTimeSeries(cpuUtilizationChart, utilizationPoints, interval, 100.0);
+    showTimeSeries(throughputChart, throughputPoints, interval, maxThroughput * 1.1);
+    
+    // One pass over the processes; past MaxProcessBars completions the charts aggregate
+    const ProcessChartSummary summary = summarizeProcesses(engine, MaxProcessBars, HistogramBins, TopProcessCount);
+    const QChart::AnimationOptions animation = summary.aggregated ? QChart::NoAnimation : QChart::SeriesAnimations;
+    for (QChart *chart : { waitingTimeChart, turnaroundTimeChart, responseTimeChart, processComparisonChart, cpuDistributionChart }) {
+        chart->setAnimationOptions(animation);
     }
     
-    // Waiting Time Chart
-    QBarSet *waitingTimeSet = new QBarSet("Waiting Time");
+    // Waiting, Turnaround and Response Time Charts: a bar per process, or how many processes fall in each range
     QStringList processCategories;
-    
-    for (const Process &process : processes) {
-        if (process.status == "Completed") {
-            *waitingTimeSet << process.waitingTime;
-            processCategories << QString("P%1").arg(process.id);
-        }
+    QList<qreal> waitingTimes;
+    QList<qreal> responseTimes;
+    QList<qreal> burstTimes;
+    for (int i : summary.processes) {
+        processCategories << QString("P%1").arg(store.id[i]);
+        waitingTimes << store.waitingTime(i);
+        responseTimes << store.responseTime(i);
+        burstTimes << store.burstTime[i];
     }
     
-    QBarSeries *waitingSeries = new QBarSeries();
-    waitingSeries->append(waitingTimeSet);
-    waitingTimeChart->addSeries(waitingSeries);
-    
-    QBarCategoryAxis *waitingAxisX = new QBarCategoryAxis();
-    waitingAxisX->append(processCategories);
-    waitingTimeChart->addAxis(waitingAxisX, Qt::AlignBottom);
-    waitingSeries->attachAxis(waitingAxisX);
-    
-    QValueAxis *waitingAxisY = new QValueAxis();
-    waitingAxisY->setRange(0, 100);  // Adjust range as needed
-    waitingTimeChart->addAxis(waitingAxisY, Qt::AlignLeft);
-    waitingSeries->attachAxis(waitingAxisY);
-    
-    // Turnaround Time Chart
-    QBarSet *turnaroundTimeSet = new QBarSet("Turnaround Time");
-    
-    for (const Process &process : processes) {
-        if (process.status == "Completed") {
-            *turnaroundTimeSet << process.turnaroundTime;
+    if (!summary.aggregated) {
+        QList<qreal> turnaroundTimes;
+        for (int i : summary.processes) {
+            turnaroundTimes << store.turnaroundTime(i);
         }
-    }
-    
-    QBarSeries *turnaroundSeries = new QBarSeries();
-    turnaroundSeries->append(turnaroundTimeSet);
-    turnaroundTimeChart->addSeries(turnaroundSeries);
-    
-    QBarCategoryAxis *turnaroundAxisX = new QBarCategoryAxis();
-    turnaroundAxisX->append(processCategories);
-    turnaroundTimeChart->addAxis(turnaroundAxisX, Qt::AlignBottom);
-    turnaroundSeries->attachAxis(turnaroundAxisX);
-    
-    QValueAxis *turnaroundAxisY = new QValueAxis();
-    turnaroundAxisY->setRange(0, 100);  // Adjust range as needed
-    turnaroundTimeChart->addAxis(turnaroundAxisY, Qt::AlignLeft);
-    turnaroundSeries->attachAxis(turnaroundAxisY);
-    
-    // Response Time Chart
-    QBarSet *responseTimeSet = new QBarSet("Response Time");
-    
-    for (const Process &process : processes) {
-        if (process.status == "Completed") {
-            *responseTimeSet << process.responseTime;
+        waitingTimeChart->setTitle("Waiting Time per Process");
+        showBars(waitingTimeChart, processCategories, { waitingTimes }, "Time");
+        turnaroundTimeChart->setTitle("Turnaround Time per Process");
+        showBars(turnaroundTimeChart, processCategories, { turnaroundTimes }, "Time");
+        responseTimeChart->setTitle("Response Time per Process");
+        showBars(responseTimeChart, processCategories, { responseTimes }, "Time");
+        processComparisonChart->setTitle("Process Time Metrics Comparison");
+        showBars(processComparisonChart, processCategories, { waitingTimes, responseTimes, burstTimes }, "Time");
+    } else {
+        waitingTimeChart->setTitle(QString("Waiting Time Distribution (%1 processes)").arg(summary.completed));
+        showBars(waitingTimeChart, binLabels(summary.waiting), { binCounts(summary.waiting) }, "Processes");
+        turnaroundTimeChart->setTitle(QString("Turnaround Time Distribution (%1 processes)").arg(summary.completed));
+        showBars(turnaroundTimeChart, binLabels(summary.turnaround), { binCounts(summary.turnaround) }, "Processes");
+        responseTimeChart->setTitle(QString("Response Time Distribution (%1 processes)").arg(summary.completed));
+        showBars(responseTimeChart, binLabels(summary.response), { binCounts(summary.response) }, "Processes");
+        
+        // The longest waits, then the mean of every other process
+        SimTime topWaiting = 0;
+        SimTime topResponse = 0;
+        SimTime topBurst = 0;
+        for (int i : summary.processes) {
+            topWaiting += store.waitingTime(i);
+            topResponse += store.responseTime(i);
+            topBurst += store.burstTime[i];
         }
-    }
-    
-    QBarSeries *responseSeries = new QBarSeries();
-    responseSeries->append(responseTimeSet);
-    responseTimeChart->addSeries(responseSeries);
-    
-    QBarCategoryAxis *responseAxisX = new QBarCategoryAxis();
-    responseAxisX->append(processCategories);
-    responseTimeChart->addAxis(responseAxisX, Qt::AlignBottom);
-    responseSeries->attachAxis(responseAxisX);
-    
-    QValueAxis *responseAxisY = new QValueAxis();
-    responseAxisY->setRange(0, 100);  // Adjust range as needed
-    responseTimeChart->addAxis(responseAxisY, Qt::AlignLeft);
-    responseSeries->attachAxis(responseAxisY);
-    
-    // Process Comparison Chart
-    QBarSet *waitingSet = new QBarSet("Waiting Time");
-    QBarSet *responseSet = new QBarSet("Response Time");
-    QBarSet *burstSet = new QBarSet("Burst Time");
-    
-    for (const Process &process : processes) {
-        if (process.status == "Completed") {
-            *waitingSet << process.waitingTime;
-            *responseSet << process.responseTime;
-            *burstSet << process.burstTime;
+        const int others = summary.completed - static_cast<int>(summary.processes.size());
+        if (others > 0) {
+            processCategories << QString("Other (mean of %1)").arg(others);
+            waitingTimes << static_cast<qreal>(engine.totalWaitingTime() - topWaiting) / others;
+            responseTimes << static_cast<qreal>(engine.totalResponseTime() - topResponse) / others;
+            burstTimes << static_cast<qreal>(summary.totalBurst - topBurst) / others;
         }
+        processComparisonChart->setTitle(QString("Process Time Metrics Comparison (%1 longest waits)").arg(summary.processes.size()));
+        showBars(processComparisonChart, processCategories, { waitingTimes, responseTimes, burstTimes }, "Time");
     }
     
-    QBarSeries *comparisonSeries = new QBarSeries();
-    comparisonSeries->append(waitingSet);
-    comparisonSeries->append(responseSet);
-    comparisonSeries->append(burstSet);
-    processComparisonChart->addSeries(comparisonSeries);
-    
-    QBarCategoryAxis *comparisonAxisX = new QBarCategoryAxis();
-    comparisonAxisX->append(processCategories);
-    processComparisonChart->addAxis(comparisonAxisX, Qt::AlignBottom);
-    comparisonSeries->attachAxis(comparisonAxisX);
-    
-    QValueAxis *comparisonAxisY = new QValueAxis();
-    comparisonAxisY->setRange(0, 100);  // Adjust range as needed
-    processComparisonChart->addAxis(comparisonAxisY, Qt::AlignLeft);
-    comparisonSeries->attachAxis(comparisonAxisY);
-    
-    // CPU Distribution Pie Chart
-    QPieSeries *pieSeries = new QPieSeries();
+    // CPU Distribution Pie Chart, as shares of the time all cores had available
+    QPieSeries *pieSeries = static_cast<QPieSeries *>(cpuDistributionChart->series().first());
+    pieSeries->clear();
+    const SimTime capacity = currentTime * engine.coreCount();
+    if (summary.completed == 0 || capacity <= 0) {
+        return;
+    }
     
-    for (const Process &process : processes) {
-        if (process.status == "Completed") {
-            pieSeries->append(QString("P%1 (%2%)").arg(process.id).arg((process.burstTime * 100) / currentTime), process.burstTime);
-            QPieSlice *slice = pieSeries->slices().last();
-            slice->setBrush(process.color);
-        }
+    const std::vector<int> &sliceProcesses = summary.aggregated ? summary.longestBursts : summary.processes;
+    SimTime shownBurst = 0;
+    for (int i : sliceProcesses) {
+        pieSeries->append(QString("P%1 (%2%)").arg(store.id[i]).arg((store.burstTime[i] * 100) / capacity), store.burstTime[i]);
+        QPieSlice *slice = pieSeries->slices().last();
+        slice->setBrush(GanttChartView::processColor(store.id[i]));
+        shownBurst += store.burstTime[i];
     }
     
-    // Add idle time slice if any
-    int totalBurstTime = 0;
-    for (const Process &process : processes) {
-        if (process.status == "Completed") {
-            totalBurstTime += process.burstTime;
-        }
+    const SimTime otherBurst = summary.totalBurst - shownBurst;
+    if (otherBurst > 0) {
+        pieSeries->append(QString("Other %1 processes (%2%)").arg(summary.completed - static_cast<int>(sliceProcesses.size()))
+                              .arg((otherBurst * 100) / capacity), otherBurst);
+        QPieSlice *otherSlice = pieSeries->slices().last();
+        otherSlice->setBrush(Qt::darkGray);
     }
     
-    int idleTime = currentTime - totalBurstTime;
+    // Add idle time slice if any
+    const SimTime idleTime = capacity - summary.totalBurst;
     if (idleTime > 0) {
-        pieSeries->append(QString("Idle (%1%)").arg((idleTime * 100) / currentTime), idleTime);
+        pieSeries->append(QString("Idle (%1%)").arg((idleTime * 100) / capacity), idleTime);
         QPieSlice *idleSlice = pieSeries->slices().last();
         idleSlice->setBrush(Qt::lightGray);
     }
-    
-    cpuDistributionChart->addSeries(pieSeries);
 }
 
 void MainWindow::on_actionImport_triggered()
@@ -901,11 +1124,89 @@ void MainWindow::on_actionImport_triggered()
     on_importButton_clicked();
 }
 
+void MainWindow::on_actionGenerateWorkload_triggered()
+{
+    GeneratorDialog dialog(this);
+    if (dialog.exec() != QDialog::Accepted) {
+        return;
+    }
+    
+    // Straight into the store in bulk, inside a single model reset
+    const WorkloadSpec spec = dialog.workloadSpec();
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    ProcessStore &store = engine.processes();
+    processTableModel->beginStoreReset();
+    generateWorkload(spec, store);
+    processIndex.rebuild(store);
+    processTableModel->endStoreReset();
+    resetSimulation();
+    QApplication::restoreOverrideCursor();
+    
+    ui->removeProcessButton->setEnabled(!store.isEmpty());
+    ui->processIdSpinBox->setValue(spec.firstId + spec.count);
+}
+
 void MainWindow::on_actionExport_triggered()
 {
     on_exportButton_clicked();
 }
 
+void MainWindow::on_actionExportTrace_triggered()
+{
+    if (engine.processes().isEmpty()) {
+        QMessageBox::warning(this, "No Data", "There are no processes to trace.");
+        return;
+    }
+    
+    QString fileName = QFileDialog::getSaveFileName(this, "Export Trace", "", "Trace Files (*.json);;All Files (*)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+    
+    // The whole run is simulated again in the background with the current
+    // settings and streamed to the file, so the trace does not depend on how
+    // far the window's simulation has got
+    auto source = std::make_shared<SchedulerEngine>();
+    source->processes() = engine.processes();
+    source->copySettings(engine);
+    auto progress = std::make_shared<TraceProgress>();
+    const std::string traceFile = QFile::encodeName(fileName).toStdString();
+    
+    QProgressDialog *progressDialog = new QProgressDialog("Writing trace...", "Cancel", 0, source->processes().size(), this);
+    progressDialog->setMinimumDuration(300);
+    connect(progressDialog, &QProgressDialog::canceled, this, [progress]() {
+        progress->cancelRequested = true;
+    });
+    
+    QFutureWatcher<QString> *watcher = new QFutureWatcher<QString>(this);
+    QTimer *progressTimer = new QTimer(watcher);
+    connect(progressTimer, &QTimer::timeout, progressDialog, [progressDialog, progress]() {
+        progressDialog->setValue(qMin(progress->completed.load(), progressDialog->maximum() - 1));
+    });
+    connect(watcher, &QFutureWatcher<QString>::finished, this, [this, watcher, progressDialog, progress]() {
+        watcher->deleteLater();
+        progressDialog->deleteLater();
+        
+        const QString errorMessage = watcher->result();
+        if (progress->cancelRequested) {
+            return;
+        }
+        if (!errorMessage.isEmpty()) {
+            QMessageBox::critical(this, "Error", errorMessage);
+            return;
+        }
+        QMessageBox::information(this, "Export Successful", "Trace exported successfully. Open it in chrome://tracing or ui.perfetto.dev.");
+    });
+    
+    watcher->setFuture(QtConcurrent::run([source, traceFile, progress]() {
+        std::string errorMessage;
+        return writeScheduleTrace(*source, traceFile, &errorMessage, progress.get())
+            ? QString()
+            : QString::fromStdString(errorMessage);
+    }));
+    progressTimer->start(50);
+}
+
 void MainWindow::on_actionExit_triggered()
 {
     QApplication::quit();
@@ -921,6 +1222,7 @@ void MainWindow::on_actionPause_triggered()
     if (simulationRunning) {
         pauseSimulation();
         ui->startSimulationButton->setText("Resume");
+        simulationStep();
     }
 }
 
@@ -929,11 +1231,38 @@ void MainWindow::on_actionReset_triggered()
     on_resetButton_clicked();
 }
 
+void MainWindow::on_actionJumpToEnd_triggered()
+{
+    if (engine.processes().isEmpty()) {
+        QMessageBox::warning(this, "No Processes", "Please add processes before starting the simulation.");
+        return;
+    }
+    
+    // The worker publishes nothing until the last completion, so the window is redrawn once
+    pauseSimulation();
+    startSimulation(true);
+    ui->startSimulationButton->setText("Pause");
+}
+
+void MainWindow::on_actionParameterSweep_triggered()
+{
+    if (engine.processes().isEmpty()) {
+        QMessageBox::warning(this, "No Processes", "Please add processes before running a parameter sweep.");
+        return;
+    }
+    
+    // The sweep works on its own copy, so the table can keep being edited meanwhile
+    SweepDialog *dialog = new SweepDialog(std::make_shared<const ProcessStore>(engine.processes()), this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->show();
+}
+
 void MainWindow::on_actionAbout_triggered()
 {
-    QMessageBox::about(this, "About FCFS Scheduler Simulation",
-                      "First-Come, First-Served (FCFS) CPU Scheduler Simulation\n\n"
-                      "This application simulates the FCFS CPU scheduling algorithm with "
+    QMessageBox::about(this, "About CPU Scheduler Simulation",
+                      "CPU Scheduler Simulation\n\n"
+                      "This application simulates the FCFS, SJF, SRTF, Round Robin and Priority "
+                      "CPU scheduling algorithms with "
                       "visual representation of the processes execution, Gantt chart, and "
                       "performance metrics.\n\n"
                       "© 2025 CPU Scheduler Simulation Project");
@@ -942,11 +1271,15 @@ void MainWindow::on_actionAbout_triggered()
 void MainWindow::on_actionDocumentation_triggered()
 {
     QMessageBox::information(this, "Documentation",
-                           "The FCFS Scheduler Simulation follows these steps:\n\n"
-                           "1. Add processes with their arrival time and burst time\n"
-                           "2. Start the simulation to see how processes are scheduled\n"
+                           "The Scheduler Simulation follows these steps:\n\n"
+                           "1. Add processes with their arrival time, burst time and priority\n"
+                           "2. Pick a scheduling policy and start the simulation to see how processes are scheduled\n"
                            "3. View real-time statistics and visualizations\n"
                            "4. Export results for further analysis\n\n"
                            "First-Come, First-Served (FCFS) is a non-preemptive scheduling algorithm "
-                           "where processes are executed in the order they arrive in the ready queue.");
+                           "where processes are executed in the order they arrive in the ready queue. "
+                           "Shortest Job First and Priority pick the shortest burst or the lowest "
+                           "priority value instead; their preemptive variants (Shortest Remaining Time "
+                           "First, Preemptive Priority) switch as soon as a better process arrives, and "
+                           "Round Robin gives each process the CPU for at most one quantum at a time.");
 }
\ No newline at end of file
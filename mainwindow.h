@@ -5,7 +5,7 @@
 #include <QGraphicsScene>
 #include <QTimer>
 #include <QVector>
-#include <QTableWidgetItem>
+#include <QModelIndex>
 #include <QChart>
 #include <QBarSeries>
 #include <QBarSet>
@@ -13,25 +13,18 @@
 #include <QPieSeries>
 #include <QMap>
 
+#include "phaseprofiler.h"
+#include "processindex.h"
+#include "schedulerengine.h"
+#include "simulationworker.h"
+
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
 
-struct Process {
-    int id;
-    int arrivalTime;
-    int burstTime;
-    int priority;
-    int completionTime;
-    int turnaroundTime;
-    int waitingTime;
-    int responseTime;
-    int remainingTime;
-    int startTime;
-    QString status;  // "Waiting", "Running", "Completed"
-    QColor color;
-    bool isCompleted;
-};
+struct CsvParseResult;
+class ProcessTableModel;
+class ProfilerDock;
 
 class MainWindow : public QMainWindow
 {
@@ -50,13 +43,27 @@ private slots:
     void on_startSimulationButton_clicked();
     void on_resetButton_clicked();
     void on_speedSlider_valueChanged(int value);
-    void on_processTableWidget_cellClicked(int row, int column);
+    void on_maxSpeedCheckBox_toggled(bool checked);
+    void on_policyComboBox_currentIndexChanged(int index);
+    void on_quantumSpinBox_valueChanged(int value);
+    void on_coresSpinBox_valueChanged(int value);
+    void on_workStealingCheckBox_toggled(bool checked);
+    void on_timelineSlider_valueChanged(int value);
+    void on_processTableView_clicked(const QModelIndex &index);
     void on_actionImport_triggered();
+    void on_actionAppendProcesses_triggered();
+    void on_actionGenerateWorkload_triggered();
     void on_actionExport_triggered();
+    void on_actionExportTrace_triggered();
     void on_actionExit_triggered();
+    void on_actionRemoveSelected_triggered();
+    void on_actionRemoveIdRange_triggered();
+    void on_actionEditSelected_triggered();
     void on_actionStart_triggered();
     void on_actionPause_triggered();
     void on_actionReset_triggered();
+    void on_actionJumpToEnd_triggered();
+    void on_actionParameterSweep_triggered();
     void on_actionAbout_triggered();
     void on_actionDocumentation_triggered();
     void on_clearButton_clicked();
@@ -68,15 +75,22 @@ private slots:
 
 private:
     Ui::MainWindow *ui;
-    QVector<Process> processes;
-    QGraphicsScene *ganttChartScene;
+    // Replica of the worker's engine that the table, the Gantt chart and the stats read
+    SchedulerEngine engine;
+    SimulationWorker simulationWorker;
+    // Slot of each process id in engine.processes(), kept in step with every edit
+    ProcessIndex processIndex;
+    PhaseProfiler profiler;
+    ProfilerDock *profilerDock;
+    ProcessTableModel *processTableModel;
     QGraphicsScene *metricsScene;
     QTimer *simulationTimer;
-    int currentTime;
+    SimTime currentTime;
+    // The latest time the run has reached, which the timeline slider spans
+    SimTime furthestTime;
     int currentProcessIndex;
     bool simulationRunning;
     bool simulationComplete;
-    QMap<int, QColor> processColors;
     
     // Chart related members
     QChart *cpuUtilizationChart;
@@ -97,18 +111,21 @@ private:
     void setupProcessTable();
     void setupGanttChart();
     void setupPerformanceCharts();
+    void setupSchedulingControls();
+    void setupProfiler();
     void setupCharts();
     void updateProcessTable();
-    void updateProcessDetails(int processIndex);
+    void updateProcessDetails(int row);
     void updateSimulationStats();
-    QColor getRandomColor();
     void resetSimulation();
     void initializeSimulation();
-    void sortProcessesByArrivalTime();
-    void startSimulation();
+    void startSimulation(bool toEnd = false);
     void pauseSimulation();
     void finishSimulation();
     bool validateProcessInput();
+    bool loadProcessFile(const QString &title, ProcessStore &imported, CsvParseResult &parseResult);
+    std::vector<int> selectedProcessRows() const;
+    void processesChanged();
     void calculateMetrics();
     void drawGanttChart();
     void drawMetricsChart();
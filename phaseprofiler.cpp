@@ -0,0 +1,147 @@
+#include "phaseprofiler.h"
+
+#include <QCoreApplication>
+#include <QEvent>
+#include <QFile>
+#include <QTextStream>
+#include <QWidget>
+
+#include <algorithm>
+#include <vector>
+
+const char *profilePhaseName(ProfilePhase phase)
+{
+    switch (phase) {
+    case ProfilePhase::Simulate:
+        return "Simulate (worker)";
+    case ProfilePhase::ApplyFrames:
+        return "Apply frames";
+    case ProfilePhase::ProcessTable:
+        return "Process table";
+    case ProfilePhase::TablePaint:
+        return "Table paint";
+    case ProfilePhase::GanttChart:
+        return "Gantt chart";
+    case ProfilePhase::GanttPaint:
+        return "Gantt paint";
+    case ProfilePhase::Details:
+        return "Process details";
+    case ProfilePhase::Stats:
+        return "Statistics";
+    case ProfilePhase::Charts:
+        return "Performance charts";
+    }
+    return "";
+}
+
+PhaseProfiler::PhaseProfiler(QObject *parent)
+    : QObject(parent)
+    , active(false)
+    , painting(false)
+{
+}
+
+void PhaseProfiler::record(ProfilePhase phase, qint64 nanoseconds)
+{
+    Window &window = windows[static_cast<int>(phase)];
+    window.samples[window.next] = nanoseconds;
+    window.next = (window.next + 1) % WindowSize;
+    window.count = std::min(window.count + 1, WindowSize);
+    ++window.total;
+}
+
+PhaseStats PhaseProfiler::stats(ProfilePhase phase) const
+{
+    const Window &window = windows[static_cast<int>(phase)];
+    PhaseStats result;
+    result.samples = window.total;
+    if (window.count == 0) {
+        return result;
+    }
+
+    std::vector<qint64> samples(window.samples.begin(), window.samples.begin() + window.count);
+    qint64 sum = 0;
+    for (qint64 sample : samples) {
+        sum += sample;
+    }
+    result.meanNs = sum / window.count;
+    result.lastNs = window.samples[(window.next + WindowSize - 1) % WindowSize];
+    result.minNs = *std::min_element(samples.begin(), samples.end());
+    result.maxNs = *std::max_element(samples.begin(), samples.end());
+    // Nearest rank: the smallest sample that at least 99% of the window does not exceed
+    const std::size_t rank = (static_cast<std::size_t>(window.count) * 99 + 99) / 100 - 1;
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    result.p99Ns = samples[rank];
+    return result;
+}
+
+void PhaseProfiler::clear()
+{
+    windows.fill(Window());
+}
+
+void PhaseProfiler::watchPaint(QWidget *widget, ProfilePhase phase)
+{
+    paintPhases.insert(widget, phase);
+    widget->installEventFilter(this);
+}
+
+bool PhaseProfiler::eventFilter(QObject *watched, QEvent *event)
+{
+    if (!active || painting || event->type() != QEvent::Paint) {
+        return false;
+    }
+    const auto phase = paintPhases.constFind(watched);
+    if (phase == paintPhases.constEnd()) {
+        return false;
+    }
+
+    // A filter only sees the event before it is handled, so deliver it from
+    // here (past this filter) to time the whole paint
+    painting = true;
+    QElapsedTimer timer;
+    timer.start();
+    QCoreApplication::sendEvent(watched, event);
+    record(phase.value(), timer.nsecsElapsed());
+    painting = false;
+    return true;
+}
+
+QString PhaseProfiler::report() const
+{
+    QString text = QString("%1 %2 %3 %4 %5 %6\n")
+        .arg("Phase (us)", -20).arg("Samples", 9).arg("Min", 9).arg("Mean", 9).arg("P99", 9).arg("Max", 9);
+    for (int i = 0; i < ProfilePhaseCount; ++i) {
+        const ProfilePhase phase = static_cast<ProfilePhase>(i);
+        const PhaseStats phaseStats = stats(phase);
+        text += QString("%1 %2 %3 %4 %5 %6\n")
+            .arg(profilePhaseName(phase), -20)
+            .arg(phaseStats.samples, 9)
+            .arg(phaseStats.minNs / 1000.0, 9, 'f', 1)
+            .arg(phaseStats.meanNs / 1000.0, 9, 'f', 1)
+            .arg(phaseStats.p99Ns / 1000.0, 9, 'f', 1)
+            .arg(phaseStats.maxNs / 1000.0, 9, 'f', 1);
+    }
+    return text;
+}
+
+bool PhaseProfiler::writeCsv(const QString &fileName, QString *errorMessage) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        if (errorMessage) {
+            *errorMessage = file.errorString();
+        }
+        return false;
+    }
+    QTextStream out(&file);
+    out << "phase,samples,min_ns,mean_ns,p99_ns,max_ns,last_ns\n";
+    for (int i = 0; i < ProfilePhaseCount; ++i) {
+        const ProfilePhase phase = static_cast<ProfilePhase>(i);
+        const PhaseStats phaseStats = stats(phase);
+        out << profilePhaseName(phase) << "," << phaseStats.samples << "," << phaseStats.minNs << ","
+            << phaseStats.meanNs << "," << phaseStats.p99Ns << "," << phaseStats.maxNs << ","
+            << phaseStats.lastNs << "\n";
+    }
+    return true;
+}
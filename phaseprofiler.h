@@ -0,0 +1,116 @@
+#ifndef PHASEPROFILER_H
+#define PHASEPROFILER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QString>
+
+#include <array>
+#include <cstdint>
+
+class QWidget;
+
+// The steps of a display refresh that the profiler tells apart
+enum class ProfilePhase : std::uint8_t {
+    Simulate,       // engine work on the simulation thread since the previous refresh
+    ApplyFrames,    // replaying the worker's frames into the window's engine
+    ProcessTable,   // signalling the changed rows
+    TablePaint,
+    GanttChart,
+    GanttPaint,
+    Details,
+    Stats,
+    Charts
+};
+
+const int ProfilePhaseCount = 9;
+
+const char *profilePhaseName(ProfilePhase phase);
+
+struct PhaseStats
+{
+    qint64 samples = 0;     // all samples since the last clear()
+    qint64 minNs = 0;       // the rest covers the rolling window
+    qint64 meanNs = 0;
+    qint64 p99Ns = 0;
+    qint64 maxNs = 0;
+    qint64 lastNs = 0;
+};
+
+// Rolling per-phase timings of the GUI thread. Disabled, a ScopedPhaseTimer
+// costs one branch and paint events one extra filter call, so the timers can
+// stay in the hot paths.
+class PhaseProfiler : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Samples per phase that min, mean and p99 are taken over
+    static const int WindowSize = 512;
+
+    explicit PhaseProfiler(QObject *parent = nullptr);
+
+    void setEnabled(bool enabled) { active = enabled; }
+    bool isEnabled() const { return active; }
+
+    void record(ProfilePhase phase, qint64 nanoseconds);
+    PhaseStats stats(ProfilePhase phase) const;
+    void clear();
+
+    // Times every paint event of widget (typically a viewport) as phase
+    void watchPaint(QWidget *widget, ProfilePhase phase);
+
+    // Fixed-width table for the overlay
+    QString report() const;
+    // "phase,samples,min_ns,mean_ns,p99_ns,max_ns,last_ns" rows
+    bool writeCsv(const QString &fileName, QString *errorMessage = nullptr) const;
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    struct Window
+    {
+        std::array<qint64, WindowSize> samples{};
+        int next = 0;
+        int count = 0;
+        qint64 total = 0;
+    };
+
+    bool active;
+    bool painting;
+    std::array<Window, ProfilePhaseCount> windows;
+    QHash<QObject *, ProfilePhase> paintPhases;
+};
+
+// Adds the time until the end of the scope to phase, if the profiler is on
+class ScopedPhaseTimer
+{
+public:
+    ScopedPhaseTimer(PhaseProfiler &profiler, ProfilePhase phase)
+        : profiler(profiler.isEnabled() ? &profiler : nullptr)
+        , phase(phase)
+    {
+        if (this->profiler) {
+            timer.start();
+        }
+    }
+
+    ~ScopedPhaseTimer()
+    {
+        if (profiler) {
+            profiler->record(phase, timer.nsecsElapsed());
+        }
+    }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer &) = delete;
+    ScopedPhaseTimer &operator=(const ScopedPhaseTimer &) = delete;
+
+private:
+    PhaseProfiler *profiler;
+    ProfilePhase phase;
+    QElapsedTimer timer;
+};
+
+#endif // PHASEPROFILER_H
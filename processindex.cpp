@@ -0,0 +1,143 @@
+#include "processindex.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+const int MinimumBits = 4;
+const std::uint64_t FibonacciMultiplier = 0x9E3779B97F4A7C15ull;
+
+} // namespace
+
+ProcessIndex::ProcessIndex()
+    : shift(64)
+    , count(0)
+    , largest(0)
+{
+}
+
+void ProcessIndex::rebuild(const ProcessStore &store)
+{
+    clear();
+    reserve(store.size());
+    for (int slot = 0; slot < store.size(); ++slot) {
+        insert(store.id[slot], slot);
+    }
+}
+
+void ProcessIndex::clear()
+{
+    std::fill(slots.begin(), slots.end(), -1);
+    count = 0;
+    largest = 0;
+}
+
+std::size_t ProcessIndex::bucketOf(int id) const
+{
+    // Spreads runs of consecutive ids over the whole table
+    return static_cast<std::size_t>((static_cast<std::uint64_t>(static_cast<std::uint32_t>(id)) * FibonacciMultiplier) >> shift);
+}
+
+int ProcessIndex::find(int id) const
+{
+    if (count == 0) {
+        return -1;
+    }
+    const std::size_t mask = slots.size() - 1;
+    for (std::size_t bucket = bucketOf(id);; bucket = (bucket + 1) & mask) {
+        if (slots[bucket] == -1) {
+            return -1;
+        }
+        if (ids[bucket] == id) {
+            return slots[bucket];
+        }
+    }
+}
+
+bool ProcessIndex::insert(int id, int slot)
+{
+    reserve(count + 1);
+    const std::size_t mask = slots.size() - 1;
+    std::size_t bucket = bucketOf(id);
+    while (slots[bucket] != -1) {
+        if (ids[bucket] == id) {
+            return false;
+        }
+        bucket = (bucket + 1) & mask;
+    }
+    ids[bucket] = id;
+    slots[bucket] = slot;
+    largest = count == 0 ? id : std::max(largest, id);
+    ++count;
+    return true;
+}
+
+void ProcessIndex::reserve(int total)
+{
+    // Keep the table at most half full, so probe runs stay short
+    if (static_cast<std::size_t>(total) * 2 <= slots.size()) {
+        return;
+    }
+    int bits = MinimumBits;
+    while ((std::size_t(1) << bits) < static_cast<std::size_t>(total) * 2) {
+        ++bits;
+    }
+    std::vector<int> oldIds(std::size_t(1) << bits);
+    std::vector<int> oldSlots(std::size_t(1) << bits, -1);
+    oldIds.swap(ids);
+    oldSlots.swap(slots);
+    shift = 64 - bits;
+
+    const std::size_t mask = slots.size() - 1;
+    for (std::size_t i = 0; i < oldSlots.size(); ++i) {
+        if (oldSlots[i] == -1) {
+            continue;
+        }
+        std::size_t bucket = bucketOf(oldIds[i]);
+        while (slots[bucket] != -1) {
+            bucket = (bucket + 1) & mask;
+        }
+        ids[bucket] = oldIds[i];
+        slots[bucket] = oldSlots[i];
+    }
+}
+
+int appendProcesses(ProcessStore &store, ProcessIndex &index, const ProcessStore &batch)
+{
+    store.reserve(store.size() + batch.size());
+    int skipped = 0;
+    for (int i = 0; i < batch.size(); ++i) {
+        if (!index.insert(batch.id[i], store.size())) {
+            ++skipped;
+            continue;
+        }
+        store.append(batch.id[i], batch.arrivalTime[i], batch.burstTime[i], batch.priority[i]);
+    }
+    return skipped;
+}
+
+int removeProcesses(ProcessStore &store, ProcessIndex &index, const std::vector<char> &marked)
+{
+    const int removed = store.removeMarked(marked);
+    // The survivors moved down, so every slot after the first removal changed
+    if (removed > 0) {
+        index.rebuild(store);
+    }
+    return removed;
+}
+
+void editProcesses(ProcessStore &store, const std::vector<int> &slots, const ProcessEdit &edit)
+{
+    for (int slot : slots) {
+        if (edit.arrivalTime >= 0) {
+            store.arrivalTime[slot] = edit.arrivalTime;
+        }
+        if (edit.burstTime >= 0) {
+            store.burstTime[slot] = edit.burstTime;
+        }
+        if (edit.priority >= 0) {
+            store.priority[slot] = edit.priority;
+        }
+    }
+}
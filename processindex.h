@@ -0,0 +1,77 @@
+#ifndef PROCESSINDEX_H
+#define PROCESSINDEX_H
+
+#include <vector>
+
+#include "schedulerengine.h"
+
+// Hash index from process id to slot in a ProcessStore, so duplicate checks
+// and lookups by id take constant time instead of a scan. Open addressing with
+// linear probing over power-of-two tables kept at most half full. Where a
+// store holds an id twice (an imported file may), the first slot wins.
+class ProcessIndex
+{
+public:
+    ProcessIndex();
+
+    // Indexes every process of store, in one pass
+    void rebuild(const ProcessStore &store);
+    void clear();
+
+    // Slot of the process with this id, -1 if there is none
+    int find(int id) const;
+    bool contains(int id) const { return find(id) != -1; }
+    // Adds id at slot; false, and nothing changes, if id is indexed already
+    bool insert(int id, int slot);
+
+    int size() const { return count; }
+    // The largest id indexed, 0 while empty
+    int maxId() const { return largest; }
+
+private:
+    std::vector<int> ids;
+    // -1 marks an empty entry
+    std::vector<int> slots;
+    int shift;
+    int count;
+    int largest;
+
+    std::size_t bucketOf(int id) const;
+    void reserve(int total);
+};
+
+// Bulk edits that keep a store and its index in step. Each takes time linear
+// in the store and the batch, however many processes it touches, so a caller
+// refreshes its views once per batch.
+
+// Appends the processes of batch whose ids the store does not hold yet (the
+// first of any repeated within batch), and returns how many were skipped
+int appendProcesses(ProcessStore &store, ProcessIndex &index, const ProcessStore &batch);
+
+// Removes the processes with marked[slot] set, keeping the order of the
+// rest, and returns how many went
+int removeProcesses(ProcessStore &store, ProcessIndex &index, const std::vector<char> &marked);
+
+// Removes the processes for which remove(store, slot) is true
+template <typename Predicate>
+int removeProcessesIf(ProcessStore &store, ProcessIndex &index, Predicate remove)
+{
+    std::vector<char> marked(store.size(), 0);
+    for (int slot = 0; slot < store.size(); ++slot) {
+        marked[slot] = remove(store, slot) ? 1 : 0;
+    }
+    return removeProcesses(store, index, marked);
+}
+
+// New values for the workload fields of some processes; -1 keeps a field
+struct ProcessEdit
+{
+    SimTime arrivalTime = -1;
+    int burstTime = -1;
+    int priority = -1;
+};
+
+// Applies edit to the processes at slots. Ids do not change, so the index stays valid.
+void editProcesses(ProcessStore &store, const std::vector<int> &slots, const ProcessEdit &edit);
+
+#endif // PROCESSINDEX_H
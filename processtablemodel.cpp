@@ -0,0 +1,114 @@
+#include "processtablemodel.h"
+
+#include <QBrush>
+
+#include <algorithm>
+
+ProcessTableModel::ProcessTableModel(const ProcessStore *store, QObject *parent)
+    : QAbstractTableModel(parent)
+    , store(store)
+{
+}
+
+int ProcessTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : store->size();
+}
+
+int ProcessTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant ProcessTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= store->size()) {
+        return QVariant();
+    }
+
+    const int row = index.row();
+
+    // Color the row based on status
+    if (role == Qt::BackgroundRole) {
+        switch (store->status[row]) {
+        case ProcessStatus::Running:
+            return QBrush(Qt::green);
+        case ProcessStatus::Completed:
+            return QBrush(Qt::gray);
+        default:
+            return QBrush(Qt::white);
+        }
+    }
+
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    const bool completed = store->completionTime[row] != -1;
+
+    switch (index.column()) {
+    case IdColumn:
+        return store->id[row];
+    case ArrivalTimeColumn:
+        return QString::number(store->arrivalTime[row]);
+    case BurstTimeColumn:
+        return store->burstTime[row];
+    case PriorityColumn:
+        return store->priority[row];
+    case StartTimeColumn:
+        return store->startTime[row] != -1 ? QString::number(store->startTime[row]) : QString("-");
+    case CompletionTimeColumn:
+        return completed ? QString::number(store->completionTime[row]) : QString("-");
+    case TurnaroundTimeColumn:
+        return completed ? QString::number(store->turnaroundTime(row)) : QString("-");
+    case WaitingTimeColumn:
+        return completed ? QString::number(store->waitingTime(row)) : QString("-");
+    case ResponseTimeColumn:
+        return completed ? QString::number(store->responseTime(row)) : QString("-");
+    case StatusColumn:
+        return QString(processStatusName(store->status[row]));
+    default:
+        return QVariant();
+    }
+}
+
+QVariant ProcessTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    static const char *const headers[ColumnCount] = {
+        "ID", "Arrival Time", "Burst Time", "Priority", "Start Time",
+        "Completion Time", "Turnaround Time", "Waiting Time", "Response Time", "Status"
+    };
+    return section >= 0 && section < ColumnCount ? QString(headers[section]) : QVariant();
+}
+
+void ProcessTableModel::beginStoreReset()
+{
+    beginResetModel();
+}
+
+void ProcessTableModel::endStoreReset()
+{
+    endResetModel();
+}
+
+void ProcessTableModel::refreshAll()
+{
+    if (store->isEmpty()) {
+        return;
+    }
+    emit dataChanged(index(0, 0), index(store->size() - 1, ColumnCount - 1));
+}
+
+void ProcessTableModel::refreshRows(const std::vector<int> &rows)
+{
+    if (rows.empty()) {
+        return;
+    }
+    // One signal for the span; the view only repaints the part of it on screen
+    const auto range = std::minmax_element(rows.begin(), rows.end());
+    emit dataChanged(index(*range.first, 0), index(*range.second, ColumnCount - 1));
+}
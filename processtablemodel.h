@@ -0,0 +1,54 @@
+#ifndef PROCESSTABLEMODEL_H
+#define PROCESSTABLEMODEL_H
+
+#include <QAbstractTableModel>
+
+#include <vector>
+
+#include "schedulerengine.h"
+
+// Read-only table over the engine's process store. Cells are formatted on
+// demand, so only the rows the view actually paints cost anything.
+class ProcessTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        IdColumn,
+        ArrivalTimeColumn,
+        BurstTimeColumn,
+        PriorityColumn,
+        StartTimeColumn,
+        CompletionTimeColumn,
+        TurnaroundTimeColumn,
+        WaitingTimeColumn,
+        ResponseTimeColumn,
+        StatusColumn,
+        ColumnCount
+    };
+
+    explicit ProcessTableModel(const ProcessStore *store, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    // Bracket edits that add or remove rows of the store: call begin before
+    // the store changes and end once it is done, so views never see the new
+    // rows before they are told
+    void beginStoreReset();
+    void endStoreReset();
+
+    // Values of every row may have changed, the rows themselves did not
+    void refreshAll();
+
+    // Only these rows changed state since the last refresh
+    void refreshRows(const std::vector<int> &rows);
+
+private:
+    const ProcessStore *store;
+};
+
+#endif // PROCESSTABLEMODEL_H
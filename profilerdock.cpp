@@ -0,0 +1,78 @@
+#include "profilerdock.h"
+#include "phaseprofiler.h"
+
+#include <QFileDialog>
+#include <QFontDatabase>
+#include <QHBoxLayout>
+#include <QMessageBox>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QVBoxLayout>
+
+// Often enough to follow a run, rarely enough not to show up in the figures
+static const int ReportRefreshInterval = 250;
+
+ProfilerDock::ProfilerDock(PhaseProfiler *profiler, QWidget *parent)
+    : QDockWidget("Profiler", parent)
+    , profiler(profiler)
+{
+    setObjectName("profilerDock");
+
+    reportEdit = new QPlainTextEdit;
+    reportEdit->setReadOnly(true);
+    reportEdit->setLineWrapMode(QPlainTextEdit::NoWrap);
+    reportEdit->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+    QPushButton *clearButton = new QPushButton("Clear");
+    QPushButton *saveButton = new QPushButton("Save...");
+    connect(clearButton, &QPushButton::clicked, this, &ProfilerDock::clearReport);
+    connect(saveButton, &QPushButton::clicked, this, &ProfilerDock::saveReport);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout;
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(clearButton);
+    buttonLayout->addWidget(saveButton);
+
+    QWidget *contents = new QWidget;
+    QVBoxLayout *layout = new QVBoxLayout(contents);
+    layout->addWidget(reportEdit);
+    layout->addLayout(buttonLayout);
+    setWidget(contents);
+
+    refreshTimer.setInterval(ReportRefreshInterval);
+    connect(&refreshTimer, &QTimer::timeout, this, &ProfilerDock::updateReport);
+    connect(this, &QDockWidget::visibilityChanged, this, [this](bool visible) {
+        this->profiler->setEnabled(visible);
+        if (visible) {
+            refreshTimer.start();
+            updateReport();
+        } else {
+            refreshTimer.stop();
+        }
+        emit profilingChanged(visible);
+    });
+}
+
+void ProfilerDock::updateReport()
+{
+    reportEdit->setPlainText(profiler->report());
+}
+
+void ProfilerDock::saveReport()
+{
+    const QString fileName = QFileDialog::getSaveFileName(this, "Save Profile", "", "CSV Files (*.csv);;All Files (*)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    QString errorMessage;
+    if (!profiler->writeCsv(fileName, &errorMessage)) {
+        QMessageBox::warning(this, "Save Error", "Could not write " + fileName + ": " + errorMessage);
+    }
+}
+
+void ProfilerDock::clearReport()
+{
+    profiler->clear();
+    updateReport();
+}
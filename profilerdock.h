@@ -0,0 +1,34 @@
+#ifndef PROFILERDOCK_H
+#define PROFILERDOCK_H
+
+#include <QDockWidget>
+#include <QTimer>
+
+class PhaseProfiler;
+class QPlainTextEdit;
+
+// Shows the profiler's per-phase min/mean/p99 table a few times a second.
+// The profiler only runs while the dock is visible.
+class ProfilerDock : public QDockWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ProfilerDock(PhaseProfiler *profiler, QWidget *parent = nullptr);
+
+signals:
+    // Emitted as the dock is shown or hidden, so other timing sources can follow
+    void profilingChanged(bool enabled);
+
+private slots:
+    void updateReport();
+    void saveReport();
+    void clearReport();
+
+private:
+    PhaseProfiler *profiler;
+    QPlainTextEdit *reportEdit;
+    QTimer refreshTimer;
+};
+
+#endif // PROFILERDOCK_H
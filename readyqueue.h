@@ -0,0 +1,234 @@
+#ifndef READYQUEUE_H
+#define READYQUEUE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// First-in first-out ready queue of process indices on a growable ring
+// buffer: push and pop are O(1) and the storage is reused across runs.
+class FifoReadyQueue
+{
+public:
+    FifoReadyQueue()
+        : head(0)
+        , count(0)
+    {
+    }
+
+    bool empty() const { return count == 0; }
+    int size() const { return static_cast<int>(count); }
+
+    void clear()
+    {
+        head = 0;
+        count = 0;
+    }
+
+    void push(int process)
+    {
+        if (count == slots.size()) {
+            grow();
+        }
+        slots[(head + count) & (slots.size() - 1)] = process;
+        ++count;
+    }
+
+    int front() const { return slots[head]; }
+
+    // Visits the queued processes from front to back
+    template <typename Visit>
+    void forEach(Visit visit) const
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            visit(slots[(head + i) & (slots.size() - 1)]);
+        }
+    }
+
+    int pop()
+    {
+        const int process = slots[head];
+        head = (head + 1) & (slots.size() - 1);
+        --count;
+        return process;
+    }
+
+private:
+    std::vector<int> slots;
+    std::size_t head;
+    std::size_t count;
+
+    void grow()
+    {
+        // Keep the capacity a power of two so wrapping is a mask
+        std::vector<int> larger(slots.empty() ? 64 : slots.size() * 2);
+        for (std::size_t i = 0; i < count; ++i) {
+            larger[i] = slots[(head + i) & (slots.size() - 1)];
+        }
+        slots.swap(larger);
+        head = 0;
+    }
+};
+
+// Ready queue ordered by a policy key such as burst time, remaining time or
+// priority (smallest first) on a binary heap. Equal keys leave in the order
+// they were queued, so ties are broken first come, first served.
+class KeyedReadyQueue
+{
+public:
+    KeyedReadyQueue()
+        : sequence(0)
+    {
+    }
+
+    bool empty() const { return heap.empty(); }
+    int size() const { return static_cast<int>(heap.size()); }
+
+    void clear()
+    {
+        heap.clear();
+        sequence = 0;
+    }
+
+    void push(std::int64_t key, int process)
+    {
+        heap.push_back({key, sequence++, process});
+        std::push_heap(heap.begin(), heap.end(), std::greater<Entry>());
+    }
+
+    std::int64_t topKey() const { return heap.front().key; }
+
+    // Visits the queued processes in no particular order
+    template <typename Visit>
+    void forEach(Visit visit) const
+    {
+        for (const Entry &entry : heap) {
+            visit(entry.process);
+        }
+    }
+
+    int pop()
+    {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<Entry>());
+        const int process = heap.back().process;
+        heap.pop_back();
+        return process;
+    }
+
+private:
+    struct Entry
+    {
+        std::int64_t key;
+        std::uint64_t sequence;
+        int process;
+
+        bool operator>(const Entry &other) const
+        {
+            return key != other.key ? key > other.key : sequence > other.sequence;
+        }
+    };
+
+    std::vector<Entry> heap;
+    std::uint64_t sequence;
+};
+
+// Next wake-up key of every core with a pending event, on a binary min-heap
+// indexed by core so an event can be moved or cancelled in O(log cores).
+// Equal keys are served in core order.
+class CoreTimerQueue
+{
+public:
+    void reset(int coreCount)
+    {
+        heap.clear();
+        position.assign(coreCount, -1);
+    }
+
+    bool empty() const { return heap.empty(); }
+    std::int64_t topKey() const { return heap.front().key; }
+    int topCore() const { return heap.front().core; }
+
+    void set(int core, std::int64_t key)
+    {
+        if (position[core] == -1) {
+            position[core] = static_cast<int>(heap.size());
+            heap.push_back({key, core});
+            siftUp(heap.size() - 1);
+        } else {
+            const std::size_t i = static_cast<std::size_t>(position[core]);
+            heap[i].key = key;
+            siftUp(i);
+            siftDown(static_cast<std::size_t>(position[core]));
+        }
+    }
+
+    void remove(int core)
+    {
+        const int i = position[core];
+        if (i == -1) {
+            return;
+        }
+        position[core] = -1;
+        const Entry last = heap.back();
+        heap.pop_back();
+        if (static_cast<std::size_t>(i) < heap.size()) {
+            heap[i] = last;
+            position[last.core] = i;
+            siftUp(i);
+            siftDown(static_cast<std::size_t>(position[last.core]));
+        }
+    }
+
+private:
+    struct Entry
+    {
+        std::int64_t key;
+        int core;
+
+        bool operator<(const Entry &other) const
+        {
+            return key != other.key ? key < other.key : core < other.core;
+        }
+    };
+
+    std::vector<Entry> heap;
+    std::vector<int> position;
+
+    void siftUp(std::size_t i)
+    {
+        const Entry entry = heap[i];
+        while (i > 0 && entry < heap[(i - 1) / 2]) {
+            heap[i] = heap[(i - 1) / 2];
+            position[heap[i].core] = static_cast<int>(i);
+            i = (i - 1) / 2;
+        }
+        heap[i] = entry;
+        position[entry.core] = static_cast<int>(i);
+    }
+
+    void siftDown(std::size_t i)
+    {
+        const Entry entry = heap[i];
+        for (;;) {
+            std::size_t child = 2 * i + 1;
+            if (child >= heap.size()) {
+                break;
+            }
+            if (child + 1 < heap.size() && heap[child + 1] < heap[child]) {
+                ++child;
+            }
+            if (!(heap[child] < entry)) {
+                break;
+            }
+            heap[i] = heap[child];
+            position[heap[i].core] = static_cast<int>(i);
+            i = child;
+        }
+        heap[i] = entry;
+        position[entry.core] = static_cast<int>(i);
+    }
+};
+
+#endif // READYQUEUE_H
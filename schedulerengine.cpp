@@ -0,0 +1,1089 @@
+#include "schedulerengine.h"
+#include "eventjournal.h"
+#include "tracewriter.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+void ProcessStore::reserve(int count)
+{
+    id.reserve(count);
+    arrivalTime.reserve(count);
+    burstTime.reserve(count);
+    priority.reserve(count);
+    startTime.reserve(count);
+    completionTime.reserve(count);
+    status.reserve(count);
+}
+
+void ProcessStore::append(int processId, SimTime arrival, int burst, int processPriority)
+{
+    id.push_back(processId);
+    arrivalTime.push_back(arrival);
+    burstTime.push_back(burst);
+    priority.push_back(processPriority);
+    startTime.push_back(-1);
+    completionTime.push_back(-1);
+    status.push_back(ProcessStatus::Waiting);
+}
+
+int ProcessStore::removeMarked(const std::vector<char> &marked)
+{
+    int kept = 0;
+    for (int index = 0; index < size(); ++index) {
+        if (marked[index]) {
+            continue;
+        }
+        if (kept != index) {
+            id[kept] = id[index];
+            arrivalTime[kept] = arrivalTime[index];
+            burstTime[kept] = burstTime[index];
+            priority[kept] = priority[index];
+            startTime[kept] = startTime[index];
+            completionTime[kept] = completionTime[index];
+            status[kept] = status[index];
+        }
+        ++kept;
+    }
+    const int removed = size() - kept;
+    id.resize(kept);
+    arrivalTime.resize(kept);
+    burstTime.resize(kept);
+    priority.resize(kept);
+    startTime.resize(kept);
+    completionTime.resize(kept);
+    status.resize(kept);
+    return removed;
+}
+
+void ProcessStore::clear()
+{
+    id.clear();
+    arrivalTime.clear();
+    burstTime.clear();
+    priority.clear();
+    startTime.clear();
+    completionTime.clear();
+    status.clear();
+}
+
+void ProcessStore::resetResults()
+{
+    std::fill(startTime.begin(), startTime.end(), -1);
+    std::fill(completionTime.begin(), completionTime.end(), -1);
+    std::fill(status.begin(), status.end(), ProcessStatus::Waiting);
+}
+
+namespace {
+
+// Compile-time scheduling policies. Keyed policies order the ready queue by
+// key() (smallest first); PreemptsOnArrival lets an arrival with a smaller key
+// than the running process take the CPU; TimeSliced requeues the running
+// process whenever its quantum expires.
+struct FcfsPolicy
+{
+    static const bool Keyed = false;
+    static const bool PreemptsOnArrival = false;
+    static const bool TimeSliced = false;
+    static SimTime key(const ProcessStore &, int, SimTime) { return 0; }
+};
+
+struct ShortestJobFirstPolicy
+{
+    static const bool Keyed = true;
+    static const bool PreemptsOnArrival = false;
+    static const bool TimeSliced = false;
+    static SimTime key(const ProcessStore &store, int index, SimTime) { return store.burstTime[index]; }
+};
+
+struct ShortestRemainingTimePolicy
+{
+    static const bool Keyed = true;
+    static const bool PreemptsOnArrival = true;
+    static const bool TimeSliced = false;
+    static SimTime key(const ProcessStore &, int, SimTime remaining) { return remaining; }
+};
+
+struct RoundRobinPolicy
+{
+    static const bool Keyed = false;
+    static const bool PreemptsOnArrival = false;
+    static const bool TimeSliced = true;
+    static SimTime key(const ProcessStore &, int, SimTime) { return 0; }
+};
+
+struct PriorityPolicy
+{
+    static const bool Keyed = true;
+    static const bool PreemptsOnArrival = false;
+    static const bool TimeSliced = false;
+    static SimTime key(const ProcessStore &store, int index, SimTime) { return store.priority[index]; }
+};
+
+struct PreemptivePriorityPolicy
+{
+    static const bool Keyed = true;
+    static const bool PreemptsOnArrival = true;
+    static const bool TimeSliced = false;
+    static SimTime key(const ProcessStore &store, int index, SimTime) { return store.priority[index]; }
+};
+
+const SimTime Never = std::numeric_limits<SimTime>::max();
+const std::size_t MaxHistoryBuckets = 4096;
+const std::size_t MaxCheckpoints = 1024;
+const std::size_t CheckpointMemoryBudget = std::size_t(64) << 20;
+
+} // namespace
+
+SchedulerEngine::SchedulerEngine()
+    : arrivalCursor(0)
+    , selectedPolicy(SchedulingPolicy::Fcfs)
+    , selectedQuantum(4)
+    , selectedCores(1)
+    , selectedStealing(false)
+    , activePolicy(SchedulingPolicy::Fcfs)
+    , quantum(4)
+    , stealing(false)
+    , cores(1)
+    , nextPlacement(0)
+    , stealState(1)
+    , now(0)
+    , runningCores(0)
+    , runningStartSum(0)
+    , queued(0)
+    , completed(0)
+    , events(0)
+    , turnaroundSum(0)
+    , waitingSum(0)
+    , responseSum(0)
+    , closedBusy(0)
+    , selectedInterval(1)
+    , intervalLength(1)
+    , historyDirty(0)
+    , recordSegments(true)
+    , publishing(false)
+    , selectedCheckpointSpacing(0)
+    , checkpointSpacing(0)
+    , checkpointBytes(0)
+    , trace(nullptr)
+    , journal(nullptr)
+{
+}
+
+void SchedulerEngine::setPolicy(SchedulingPolicy policy, SimTime timeQuantum)
+{
+    selectedPolicy = policy;
+    selectedQuantum = std::max<SimTime>(timeQuantum, 1);
+}
+
+void SchedulerEngine::setCoreCount(int count)
+{
+    selectedCores = std::max(count, 1);
+}
+
+void SchedulerEngine::reset()
+{
+    store.resetResults();
+    activePolicy = selectedPolicy;
+    quantum = selectedQuantum;
+    stealing = selectedStealing;
+    remainingWork = store.burstTime;
+    processCore.assign(store.size(), -1);
+
+    // Arrivals are admitted in arrival order; ties keep their insertion order.
+    // Workloads are usually stored sorted already, which skips the sort.
+    arrivalOrder.resize(store.size());
+    std::iota(arrivalOrder.begin(), arrivalOrder.end(), 0);
+    auto byArrival = [this](int a, int b) {
+        return store.arrivalTime[a] < store.arrivalTime[b];
+    };
+    if (!std::is_sorted(arrivalOrder.begin(), arrivalOrder.end(), byArrival)) {
+        std::stable_sort(arrivalOrder.begin(), arrivalOrder.end(), byArrival);
+    }
+    arrivalCursor = 0;
+
+    // Every core starts idle; the lowest-numbered one is handed work first
+    cores.clear();
+    cores.resize(selectedCores);
+    timers.reset(selectedCores);
+    idleCores.clear();
+    for (int core = selectedCores - 1; core >= 0; --core) {
+        idleCores.push_back(core);
+    }
+    loadedCores.clear();
+    touchedCores.clear();
+    nextPlacement = 0;
+    stealState = 0x9E3779B97F4A7C15ull;
+
+    now = 0;
+    runningCores = 0;
+    runningStartSum = 0;
+    queued = 0;
+    completed = 0;
+    events = 0;
+    changed.clear();
+    turnaroundSum = 0;
+    waitingSum = 0;
+    responseSum = 0;
+    turnaroundTimes.clear();
+    waitingTimes.clear();
+    responseTimes.clear();
+    closedBusy = 0;
+    intervalLength = selectedInterval;
+    history.clear();
+    completions.clear();
+    historyDirty = 0;
+
+    unpublished.clear();
+    unpublishedMark.assign(publishing ? store.size() : 0, 0);
+    publishedSegments.assign(selectedCores, 0);
+
+    // The checkpoint at time 0 is the state before any event, so every seek has one to start from
+    checkpointSpacing = selectedCheckpointSpacing;
+    checkpoints.clear();
+    checkpointBytes = 0;
+    completionJournal.clear();
+    if (checkpointSpacing > 0) {
+        saveCheckpoint(0);
+    }
+}
+
+void SchedulerEngine::advanceTo(SimTime time)
+{
+    changed.clear();
+    advance(time);
+    collectUnpublished();
+}
+
+void SchedulerEngine::run()
+{
+    changed.clear();
+    advance(Never);
+    collectUnpublished();
+}
+
+void SchedulerEngine::seekTo(SimTime time)
+{
+    changed.clear();
+    time = std::max<SimTime>(time, 0);
+
+    // The latest checkpoint at or before time
+    auto after = std::upper_bound(checkpoints.begin(), checkpoints.end(), time,
+                                  [](SimTime value, const Checkpoint &checkpoint) { return value < checkpoint.time; });
+    if (after != checkpoints.begin()) {
+        const Checkpoint &checkpoint = *(after - 1);
+        // Forwards, restoring only pays off past a checkpoint ahead of the clock
+        if (time < now || checkpoint.time > now) {
+            restoreCheckpoint(checkpoint);
+        }
+    }
+    if (time >= now) {
+        advance(time);
+    }
+    collectUnpublished();
+}
+
+void SchedulerEngine::advance(SimTime time)
+{
+    // A checkpoint is taken between ticks, after every event of its tick
+    while (checkpointSpacing > 0 && !isFinished()) {
+        const SimTime next = nextCheckpointTime();
+        if (next > time) {
+            break;
+        }
+        simulate(next);
+        if (isFinished()) {
+            break;
+        }
+        now = std::max(now, next);
+        saveCheckpoint(next);
+    }
+    simulate(time);
+    // Like run(), the clock stops at the last completion
+    if (!isFinished() && time != Never) {
+        now = std::max(now, time);
+    }
+}
+
+SimTime SchedulerEngine::remainingTime(int index) const
+{
+    switch (store.status[index]) {
+    case ProcessStatus::Running:
+        return cores[processCore[index]].runningEnd - now;
+    case ProcessStatus::Completed:
+        return 0;
+    default:
+        return static_cast<std::size_t>(index) < remainingWork.size() ? remainingWork[index] : store.burstTime[index];
+    }
+}
+
+SimTime SchedulerEngine::coreBusyTime(int core) const
+{
+    const Core &state = cores[core];
+    return state.running == -1 ? state.closedBusy : state.closedBusy + (now - state.segmentStart);
+}
+
+void SchedulerEngine::setHistoryInterval(SimTime interval)
+{
+    selectedInterval = std::max<SimTime>(interval, 1);
+    intervalLength = selectedInterval;
+    history.clear();
+    completions.clear();
+    historyDirty = 0;
+}
+
+void SchedulerEngine::copySettings(const SchedulerEngine &other)
+{
+    selectedPolicy = other.selectedPolicy;
+    selectedQuantum = other.selectedQuantum;
+    selectedCores = other.selectedCores;
+    selectedStealing = other.selectedStealing;
+    selectedCheckpointSpacing = other.selectedCheckpointSpacing;
+    setHistoryInterval(other.selectedInterval);
+    recordSegments = other.recordSegments;
+}
+
+void SchedulerEngine::collectUnpublished()
+{
+    if (!publishing) {
+        return;
+    }
+    // A process can change several times between two frames but is sent once
+    for (int index : changed) {
+        if (!unpublishedMark[index]) {
+            unpublishedMark[index] = 1;
+            unpublished.push_back(index);
+        }
+    }
+}
+
+void SchedulerEngine::publishFrame(SimulationFrame &frame)
+{
+    frame.time = now;
+    frame.completed = completed;
+    frame.queued = queued;
+    frame.runningCores = runningCores;
+    frame.runningStartSum = runningStartSum;
+    frame.events = events;
+    frame.turnaroundSum = turnaroundSum;
+    frame.waitingSum = waitingSum;
+    frame.responseSum = responseSum;
+    frame.turnaroundMax = turnaroundTimes.max();
+    frame.waitingMax = waitingTimes.max();
+    frame.responseMax = responseTimes.max();
+    frame.closedBusy = closedBusy;
+
+    frame.processes.clear();
+    for (int index : unpublished) {
+        unpublishedMark[index] = 0;
+        frame.processes.push_back({index, store.status[index], processCore[index], remainingWork[index],
+                                   store.startTime[index], store.completionTime[index]});
+    }
+    unpublished.clear();
+
+    // A running process's segment is still open, so it is sent again until it closes
+    frame.cores.clear();
+    frame.segments.clear();
+    for (int core = 0; core < coreCount(); ++core) {
+        const Core &state = cores[core];
+        const std::size_t first = publishedSegments[core];
+        frame.cores.push_back({state.running, state.runningEnd, state.segmentStart, state.closedBusy,
+                               first, state.segments.size() - first});
+        frame.segments.insert(frame.segments.end(), state.segments.begin() + first, state.segments.end());
+        publishedSegments[core] = state.segments.size() - (state.running != -1 && recordSegments ? 1 : 0);
+    }
+
+    frame.historyInterval = intervalLength;
+    frame.firstHistoryBucket = std::min(historyDirty, history.size());
+    frame.history.assign(history.begin() + frame.firstHistoryBucket, history.end());
+    frame.completions.assign(completions.begin() + frame.firstHistoryBucket, completions.end());
+    historyDirty = history.size();
+}
+
+void SchedulerEngine::applyFrame(const SimulationFrame &frame)
+{
+    now = frame.time;
+    completed = frame.completed;
+    queued = frame.queued;
+    runningCores = frame.runningCores;
+    runningStartSum = frame.runningStartSum;
+    events = frame.events;
+    turnaroundSum = frame.turnaroundSum;
+    waitingSum = frame.waitingSum;
+    responseSum = frame.responseSum;
+    closedBusy = frame.closedBusy;
+
+    changed.clear();
+    for (const ProcessUpdate &update : frame.processes) {
+        // Frames carry completions rather than the histograms, which are far
+        // larger; after a seek backwards they take completions back
+        const bool completes = update.status == ProcessStatus::Completed
+            && store.status[update.index] != ProcessStatus::Completed;
+        if (store.status[update.index] == ProcessStatus::Completed && update.status != ProcessStatus::Completed) {
+            turnaroundTimes.remove(store.turnaroundTime(update.index));
+            waitingTimes.remove(store.waitingTime(update.index));
+            responseTimes.remove(store.responseTime(update.index));
+        }
+        store.status[update.index] = update.status;
+        store.startTime[update.index] = update.startTime;
+        store.completionTime[update.index] = update.completionTime;
+        processCore[update.index] = update.core;
+        remainingWork[update.index] = update.remaining;
+        changed.push_back(update.index);
+        if (completes) {
+            turnaroundTimes.record(store.turnaroundTime(update.index));
+            waitingTimes.record(store.waitingTime(update.index));
+            responseTimes.record(store.responseTime(update.index));
+        }
+    }
+    turnaroundTimes.restoreMax(frame.turnaroundMax);
+    waitingTimes.restoreMax(frame.waitingMax);
+    responseTimes.restoreMax(frame.responseMax);
+
+    auto segment = frame.segments.begin();
+    for (int core = 0; core < coreCount(); ++core) {
+        const CoreUpdate &update = frame.cores[core];
+        Core &state = cores[core];
+        state.running = update.running;
+        state.runningEnd = update.runningEnd;
+        state.segmentStart = update.segmentStart;
+        state.closedBusy = update.closedBusy;
+        state.segments.resize(update.firstSegment);
+        state.segments.insert(state.segments.end(), segment, segment + update.segmentCount);
+        segment += update.segmentCount;
+    }
+
+    // A merge since the previous frame resends the whole history
+    intervalLength = frame.historyInterval;
+    history.resize(frame.firstHistoryBucket);
+    history.insert(history.end(), frame.history.begin(), frame.history.end());
+    completions.resize(frame.firstHistoryBucket);
+    completions.insert(completions.end(), frame.completions.begin(), frame.completions.end());
+}
+
+void SchedulerEngine::addBusySpan(Core &core, SimTime begin, SimTime end)
+{
+    if (end <= begin) {
+        return;
+    }
+    core.closedBusy += end - begin;
+    closedBusy += end - begin;
+
+    historyBucket(end - 1);
+    historyDirty = std::min(historyDirty, static_cast<std::size_t>(begin / intervalLength));
+    while (begin < end) {
+        const SimTime bucket = begin / intervalLength;
+        const SimTime bucketEnd = std::min(end, (bucket + 1) * intervalLength);
+        history[bucket] += bucketEnd - begin;
+        begin = bucketEnd;
+    }
+}
+
+std::size_t SchedulerEngine::historyBucket(SimTime time)
+{
+    while (static_cast<std::size_t>(time / intervalLength) >= MaxHistoryBuckets) {
+        mergeHistory();
+    }
+    const std::size_t bucket = static_cast<std::size_t>(time / intervalLength);
+    if (history.size() <= bucket) {
+        history.resize(bucket + 1, 0);
+        completions.resize(bucket + 1, 0);
+    }
+    return bucket;
+}
+
+void SchedulerEngine::mergeHistory()
+{
+    // Bucket k of the doubled interval covers old buckets 2k and 2k + 1
+    const std::size_t merged = (history.size() + 1) / 2;
+    for (std::size_t bucket = 0; bucket < merged; ++bucket) {
+        const std::size_t second = 2 * bucket + 1;
+        history[bucket] = history[2 * bucket] + (second < history.size() ? history[second] : 0);
+        completions[bucket] = completions[2 * bucket] + (second < completions.size() ? completions[second] : 0);
+    }
+    history.resize(merged);
+    completions.resize(merged);
+    intervalLength *= 2;
+    historyDirty = 0;
+}
+
+void SchedulerEngine::setCheckpointInterval(SimTime interval)
+{
+    selectedCheckpointSpacing = std::max<SimTime>(interval, 0);
+}
+
+SimTime SchedulerEngine::nextEventTime() const
+{
+    const SimTime arrivalKey = arrivalCursor < arrivalOrder.size() ? 2 * store.arrivalTime[arrivalOrder[arrivalCursor]] : Never;
+    const SimTime timerKey = timers.empty() ? Never : timers.topKey();
+    const SimTime key = std::min(arrivalKey, timerKey);
+    return key == Never ? Never : key / 2;
+}
+
+SimTime SchedulerEngine::nextCheckpointTime() const
+{
+    // Through a quiet stretch every checkpoint would be the same, so skip to the last one before the next event
+    const SimTime last = checkpoints.back().time;
+    const SimTime event = nextEventTime();
+    if (event != Never && event > last + checkpointSpacing) {
+        return last + (event - last) / checkpointSpacing * checkpointSpacing;
+    }
+    return last + checkpointSpacing;
+}
+
+void SchedulerEngine::saveCheckpoint(SimTime time)
+{
+    Checkpoint checkpoint;
+    checkpoint.time = time;
+    checkpoint.arrivalCursor = arrivalCursor;
+    checkpoint.nextPlacement = nextPlacement;
+    checkpoint.stealState = stealState;
+    checkpoint.runningCores = runningCores;
+    checkpoint.runningStartSum = runningStartSum;
+    checkpoint.queued = queued;
+    checkpoint.completed = completed;
+    checkpoint.events = events;
+    checkpoint.turnaroundSum = turnaroundSum;
+    checkpoint.waitingSum = waitingSum;
+    checkpoint.responseSum = responseSum;
+    checkpoint.turnaroundMax = turnaroundTimes.max();
+    checkpoint.waitingMax = waitingTimes.max();
+    checkpoint.responseMax = responseTimes.max();
+    checkpoint.closedBusy = closedBusy;
+    checkpoint.intervalLength = intervalLength;
+    checkpoint.history = history;
+    checkpoint.completions = completions;
+    checkpoint.timers = timers;
+    checkpoint.idleCores = idleCores;
+    checkpoint.loadedCores = loadedCores;
+
+    // Every process in flight is either running or queued on some core
+    auto addProcess = [&](int index) {
+        checkpoint.processes.push_back({index, store.status[index], processCore[index], remainingWork[index],
+                                        store.startTime[index]});
+    };
+    checkpoint.cores.reserve(cores.size());
+    for (Core &state : cores) {
+        dropReplayedSegments(state);
+        CoreCheckpoint saved{state.running, state.runningEnd, state.segmentStart, state.sliceStart, state.sliceEnd,
+                             state.freeAt, state.closedBusy, state.loadedSlot, state.segments.size(), {}, state.keyedQueue};
+        saved.fifoQueue.reserve(state.fifoQueue.size());
+        state.fifoQueue.forEach([&](int index) {
+            saved.fifoQueue.push_back(index);
+            addProcess(index);
+        });
+        state.keyedQueue.forEach(addProcess);
+        if (state.running != -1) {
+            addProcess(state.running);
+        }
+        checkpoint.cores.push_back(std::move(saved));
+    }
+
+    checkpoint.bytes = sizeof(Checkpoint)
+        + (checkpoint.history.size() + checkpoint.completions.size()) * sizeof(SimTime)
+        + cores.size() * (sizeof(CoreCheckpoint) + 2 * sizeof(int))
+        + static_cast<std::size_t>(queued) * (sizeof(int) + 3 * sizeof(std::int64_t))
+        + checkpoint.processes.size() * sizeof(ProcessCheckpoint);
+    checkpointBytes += checkpoint.bytes;
+    checkpoints.push_back(std::move(checkpoint));
+    thinCheckpoints();
+}
+
+void SchedulerEngine::thinCheckpoints()
+{
+    while (checkpoints.size() > 2 && (checkpoints.size() > MaxCheckpoints || checkpointBytes > CheckpointMemoryBudget)) {
+        // Every other checkpoint stays, the one at time 0 included, at twice the spacing
+        std::size_t kept = 0;
+        checkpointBytes = 0;
+        for (std::size_t i = 0; i < checkpoints.size(); i += 2) {
+            if (kept != i) {
+                checkpoints[kept] = std::move(checkpoints[i]);
+            }
+            checkpointBytes += checkpoints[kept].bytes;
+            ++kept;
+        }
+        checkpoints.resize(kept);
+        checkpointSpacing *= 2;
+    }
+}
+
+void SchedulerEngine::clearProcess(int index)
+{
+    store.status[index] = ProcessStatus::Waiting;
+    store.startTime[index] = -1;
+    store.completionTime[index] = -1;
+    processCore[index] = -1;
+    remainingWork[index] = store.burstTime[index];
+    changed.push_back(index);
+}
+
+void SchedulerEngine::restoreCheckpoint(const Checkpoint &checkpoint)
+{
+    // Going back, processes that completed or arrived after the checkpoint
+    // return to how reset() left them; the ones in flight at the checkpoint
+    // are set below
+    for (int k = checkpoint.completed; k < completed; ++k) {
+        const int index = completionJournal[k].index;
+        turnaroundTimes.remove(store.turnaroundTime(index));
+        waitingTimes.remove(store.waitingTime(index));
+        responseTimes.remove(store.responseTime(index));
+        clearProcess(index);
+    }
+    for (std::size_t k = checkpoint.arrivalCursor; k < arrivalCursor; ++k) {
+        clearProcess(arrivalOrder[k]);
+    }
+    // Going forwards, the journal has what completed in between
+    for (int k = completed; k < checkpoint.completed; ++k) {
+        const CompletionRecord &record = completionJournal[k];
+        store.status[record.index] = ProcessStatus::Completed;
+        store.startTime[record.index] = record.startTime;
+        store.completionTime[record.index] = record.completionTime;
+        processCore[record.index] = record.core;
+        remainingWork[record.index] = 0;
+        changed.push_back(record.index);
+        turnaroundTimes.record(store.turnaroundTime(record.index));
+        waitingTimes.record(store.waitingTime(record.index));
+        responseTimes.record(store.responseTime(record.index));
+    }
+    for (const ProcessCheckpoint &process : checkpoint.processes) {
+        store.status[process.index] = process.status;
+        store.startTime[process.index] = process.startTime;
+        store.completionTime[process.index] = -1;
+        processCore[process.index] = process.core;
+        remainingWork[process.index] = process.remaining;
+        changed.push_back(process.index);
+    }
+    turnaroundTimes.restoreMax(checkpoint.turnaroundMax);
+    waitingTimes.restoreMax(checkpoint.waitingMax);
+    responseTimes.restoreMax(checkpoint.responseMax);
+
+    for (int core = 0; core < coreCount(); ++core) {
+        Core &state = cores[core];
+        const CoreCheckpoint &saved = checkpoint.cores[core];
+        state.running = saved.running;
+        state.runningEnd = saved.runningEnd;
+        state.segmentStart = saved.segmentStart;
+        state.sliceStart = saved.sliceStart;
+        state.sliceEnd = saved.sliceEnd;
+        state.freeAt = saved.freeAt;
+        state.closedBusy = saved.closedBusy;
+        state.loadedSlot = saved.loadedSlot;
+        state.touched = false;
+        state.fifoQueue.clear();
+        for (const int index : saved.fifoQueue) {
+            state.fifoQueue.push(index);
+        }
+        state.keyedQueue = saved.keyedQueue;
+        if (recordSegments) {
+            restoreSegments(state, saved.segmentCount);
+        }
+        // A segment that was closed when published may be open again
+        const std::size_t open = state.running != -1 && recordSegments ? 1 : 0;
+        publishedSegments[core] = std::min(publishedSegments[core], state.segments.size() - open);
+    }
+
+    arrivalCursor = checkpoint.arrivalCursor;
+    timers = checkpoint.timers;
+    idleCores = checkpoint.idleCores;
+    loadedCores = checkpoint.loadedCores;
+    touchedCores.clear();
+    nextPlacement = checkpoint.nextPlacement;
+    stealState = checkpoint.stealState;
+    now = checkpoint.time;
+    runningCores = checkpoint.runningCores;
+    runningStartSum = checkpoint.runningStartSum;
+    queued = checkpoint.queued;
+    completed = checkpoint.completed;
+    events = checkpoint.events;
+    turnaroundSum = checkpoint.turnaroundSum;
+    waitingSum = checkpoint.waitingSum;
+    responseSum = checkpoint.responseSum;
+    closedBusy = checkpoint.closedBusy;
+    intervalLength = checkpoint.intervalLength;
+    history = checkpoint.history;
+    completions = checkpoint.completions;
+    historyDirty = 0;
+}
+
+void SchedulerEngine::restoreSegments(Core &core, std::size_t count)
+{
+    dropReplayedSegments(core);
+    // A segment still running is not final, so only finished ones are set aside
+    std::size_t finished = core.segments.size();
+    if (finished > 0 && core.segments.back().end == -1) {
+        --finished;
+    }
+    // The checkpoint's own running segment is rebuilt from the core below
+    const std::size_t keep = core.running != -1 && count > 0 ? count - 1 : count;
+    if (finished > keep) {
+        // Set aside what comes after the checkpoint, in case a seek comes back for it
+        for (std::size_t i = finished; i-- > keep;) {
+            core.rewoundSegments.push_back(core.segments[i]);
+        }
+        core.rewoundStart = keep;
+    }
+    core.segments.resize(std::min(finished, keep));
+    // Going forwards, the finished segments in between come back from the ones set aside
+    while (core.segments.size() < keep && !core.rewoundSegments.empty()) {
+        core.segments.push_back(core.rewoundSegments.back());
+        core.rewoundSegments.pop_back();
+        ++core.rewoundStart;
+    }
+    if (core.running != -1) {
+        core.segments.push_back({core.running, core.segmentStart, -1});
+    }
+}
+
+void SchedulerEngine::dropReplayedSegments(Core &core)
+{
+    // Simulating is deterministic, so a segment recreated since the seek equals the one set aside.
+    // One still running is not finished yet, so the one set aside stays until it is.
+    std::size_t finished = core.segments.size();
+    if (finished > 0 && core.segments.back().end == -1) {
+        --finished;
+    }
+    while (!core.rewoundSegments.empty() && core.rewoundStart < finished) {
+        core.rewoundSegments.pop_back();
+        ++core.rewoundStart;
+    }
+}
+
+void SchedulerEngine::simulate(SimTime limit)
+{
+    switch (activePolicy) {
+    case SchedulingPolicy::ShortestJobFirst:
+        processEvents<ShortestJobFirstPolicy>(limit);
+        break;
+    case SchedulingPolicy::ShortestRemainingTime:
+        processEvents<ShortestRemainingTimePolicy>(limit);
+        break;
+    case SchedulingPolicy::RoundRobin:
+        processEvents<RoundRobinPolicy>(limit);
+        break;
+    case SchedulingPolicy::Priority:
+        processEvents<PriorityPolicy>(limit);
+        break;
+    case SchedulingPolicy::PreemptivePriority:
+        processEvents<PreemptivePriorityPolicy>(limit);
+        break;
+    default:
+        processEvents<FcfsPolicy>(limit);
+        break;
+    }
+}
+
+template <typename Policy>
+void SchedulerEngine::makeReady(int core, int index)
+{
+    if constexpr (Policy::Keyed) {
+        cores[core].keyedQueue.push(Policy::key(store, index, remainingWork[index]), index);
+    } else {
+        cores[core].fifoQueue.push(index);
+    }
+    processCore[index] = core;
+    ++queued;
+    if (trace) {
+        trace->readyCount(now, queued);
+    }
+}
+
+template <typename Policy>
+int SchedulerEngine::takeReady(int core)
+{
+    --queued;
+    if (trace) {
+        trace->readyCount(now, queued);
+    }
+    if constexpr (Policy::Keyed) {
+        return cores[core].keyedQueue.pop();
+    } else {
+        return cores[core].fifoQueue.pop();
+    }
+}
+
+void SchedulerEngine::updateLoaded(int core)
+{
+    // A core is a stealing victim while work waits behind its running process
+    Core &state = cores[core];
+    const bool loaded = state.running != -1 && !state.queueEmpty();
+    if (loaded && state.loadedSlot == -1) {
+        state.loadedSlot = static_cast<int>(loadedCores.size());
+        loadedCores.push_back(core);
+    } else if (!loaded && state.loadedSlot != -1) {
+        const int moved = loadedCores.back();
+        loadedCores[state.loadedSlot] = moved;
+        cores[moved].loadedSlot = state.loadedSlot;
+        loadedCores.pop_back();
+        state.loadedSlot = -1;
+    }
+}
+
+void SchedulerEngine::wakeIdleCore(SimTime time)
+{
+    if (!stealing || idleCores.empty() || loadedCores.empty()) {
+        return;
+    }
+    const int core = idleCores.back();
+    idleCores.pop_back();
+    timers.set(core, 2 * std::max(cores[core].freeAt, time));
+}
+
+void SchedulerEngine::armTimer(int core)
+{
+    // Events at tick t are keyed 2t at the start of the tick (arrivals, quantum
+    // expiries, dispatches) and 2t + 1 at its end (completions)
+    const Core &state = cores[core];
+    SimTime key = 2 * state.runningEnd + 1;
+    if (state.sliceEnd != Never && 2 * state.sliceEnd < key) {
+        key = 2 * state.sliceEnd;
+    }
+    timers.set(core, key);
+}
+
+template <typename Policy>
+bool SchedulerEngine::steal(int core)
+{
+    if (!stealing || loadedCores.empty()) {
+        return false;
+    }
+
+    // xorshift64 keeps victim selection cheap and the run reproducible
+    stealState ^= stealState << 13;
+    stealState ^= stealState >> 7;
+    stealState ^= stealState << 17;
+    const int victim = loadedCores[stealState % loadedCores.size()];
+
+    makeReady<Policy>(core, takeReady<Policy>(victim));
+    updateLoaded(victim);
+    ++events;
+    return true;
+}
+
+template <typename Policy>
+void SchedulerEngine::dispatch(int core, SimTime time)
+{
+    Core &state = cores[core];
+    const int next = takeReady<Policy>(core);
+
+    store.status[next] = ProcessStatus::Running;
+    if (store.startTime[next] == -1) {
+        store.startTime[next] = time;
+    }
+    changed.push_back(next);
+    now = time;
+    state.running = next;
+    state.segmentStart = time;
+    state.sliceStart = time;
+    state.sliceEnd = Policy::TimeSliced ? time + quantum : Never;
+    // A zero-length burst still occupies the tick it is dispatched in
+    state.runningEnd = time + std::max(remainingWork[next], 1) - 1;
+    state.freeAt = state.runningEnd + 1;
+    ++runningCores;
+    runningStartSum += time;
+    if (recordSegments) {
+        state.segments.push_back({next, time, -1});
+    }
+    if (journal) {
+        journal->record(JournalEventType::Dispatch, time, core, next);
+    }
+    ++events;
+}
+
+void SchedulerEngine::preempt(int core, SimTime time)
+{
+    // The process ran ticks [segmentStart, time) and leaves the CPU for the one dispatched at time
+    Core &state = cores[core];
+    const int process = state.running;
+    remainingWork[process] -= static_cast<int>(time - state.segmentStart);
+    store.status[process] = ProcessStatus::Waiting;
+    changed.push_back(process);
+    now = time;
+    addBusySpan(state, state.segmentStart, time);
+    if (recordSegments) {
+        state.segments.back().end = time - 1;
+    }
+    if (trace) {
+        trace->segment(core, store.id[process], state.segmentStart, time - 1, false);
+    }
+    if (journal) {
+        journal->record(JournalEventType::Preempt, time, core, process);
+    }
+    state.freeAt = time;
+    state.running = -1;
+    --runningCores;
+    runningStartSum -= state.segmentStart;
+    ++events;
+}
+
+void SchedulerEngine::complete(int core)
+{
+    Core &state = cores[core];
+    const int process = state.running;
+    remainingWork[process] = 0;
+    store.status[process] = ProcessStatus::Completed;
+    store.completionTime[process] = state.runningEnd;
+    changed.push_back(process);
+    now = state.runningEnd;
+    addBusySpan(state, state.segmentStart, state.runningEnd);
+    const std::size_t bucket = historyBucket(state.runningEnd);
+    ++completions[bucket];
+    historyDirty = std::min(historyDirty, bucket);
+    // A completion replayed after a seek backwards is in the journal already
+    if (checkpointSpacing > 0 && static_cast<std::size_t>(completed) == completionJournal.size()) {
+        completionJournal.push_back({process, core, store.startTime[process], state.runningEnd});
+    }
+    turnaroundSum += store.turnaroundTime(process);
+    waitingSum += store.waitingTime(process);
+    responseSum += store.responseTime(process);
+    turnaroundTimes.record(store.turnaroundTime(process));
+    waitingTimes.record(store.waitingTime(process));
+    responseTimes.record(store.responseTime(process));
+    if (recordSegments) {
+        state.segments.back().end = state.runningEnd;
+    }
+    if (trace) {
+        trace->segment(core, store.id[process], state.segmentStart, state.runningEnd, true);
+    }
+    if (journal) {
+        journal->record(JournalEventType::Complete, state.runningEnd, core, process);
+    }
+    state.running = -1;
+    --runningCores;
+    runningStartSum -= state.segmentStart;
+    ++completed;
+    ++events;
+}
+
+template <typename Policy>
+void SchedulerEngine::admitArrivals(SimTime time)
+{
+    now = std::max(now, time);
+    while (arrivalCursor < arrivalOrder.size() && store.arrivalTime[arrivalOrder[arrivalCursor]] <= time) {
+        const int index = arrivalOrder[arrivalCursor];
+        ++arrivalCursor;
+        ++events;
+
+        int core;
+        if (!idleCores.empty()) {
+            core = idleCores.back();
+            idleCores.pop_back();
+        } else {
+            core = nextPlacement;
+            nextPlacement = nextPlacement + 1 == coreCount() ? 0 : nextPlacement + 1;
+        }
+        makeReady<Policy>(core, index);
+        if (journal) {
+            journal->record(JournalEventType::Arrival, time, core, index);
+        }
+
+        Core &state = cores[core];
+        if (state.running == -1) {
+            timers.set(core, 2 * std::max(state.freeAt, time));
+        } else {
+            if ((Policy::PreemptsOnArrival || Policy::TimeSliced) && !state.touched) {
+                state.touched = true;
+                touchedCores.push_back(core);
+            }
+            updateLoaded(core);
+            wakeIdleCore(time);
+        }
+    }
+
+    // Every arrival of the tick is queued before a running process is reconsidered
+    for (const int core : touchedCores) {
+        Core &state = cores[core];
+        state.touched = false;
+        if constexpr (Policy::PreemptsOnArrival) {
+            // The running process still has the ticks [time, runningEnd] to go
+            if (state.keyedQueue.topKey() < Policy::key(store, state.running, state.runningEnd - time + 1)) {
+                const int preempted = state.running;
+                preempt(core, time);
+                makeReady<Policy>(core, preempted);
+                dispatch<Policy>(core, time);
+                armTimer(core);
+            }
+        }
+        if constexpr (Policy::TimeSliced) {
+            // An open slice expires at the first quantum boundary from now on
+            if (state.sliceEnd == Never) {
+                state.sliceEnd = state.sliceStart + std::max<SimTime>((time - state.sliceStart + quantum - 1) / quantum, 1) * quantum;
+                armTimer(core);
+            }
+        }
+    }
+    touchedCores.clear();
+}
+
+template <typename Policy>
+void SchedulerEngine::runCore(int core, SimTime time)
+{
+    Core &state = cores[core];
+    now = time;
+
+    if (state.running != -1) {
+        // Round Robin quantum expiry
+        if (state.queueEmpty()) {
+            // Nothing to switch to: the slice stays open until work is queued here
+            state.sliceEnd = Never;
+            armTimer(core);
+            return;
+        }
+        const int expired = state.running;
+        preempt(core, time);
+        makeReady<Policy>(core, expired);
+    } else if (state.queueEmpty() && !steal<Policy>(core)) {
+        idleCores.push_back(core);
+        return;
+    }
+
+    dispatch<Policy>(core, time);
+    armTimer(core);
+    updateLoaded(core);
+    wakeIdleCore(time);
+}
+
+template <typename Policy>
+void SchedulerEngine::finishCore(int core)
+{
+    complete(core);
+    updateLoaded(core);
+
+    // The core is free from the next tick on; with stealing it looks for work then
+    Core &state = cores[core];
+    if (!state.queueEmpty() || (stealing && !loadedCores.empty())) {
+        timers.set(core, 2 * state.freeAt);
+    } else {
+        idleCores.push_back(core);
+    }
+}
+
+template <typename Policy>
+void SchedulerEngine::processEvents(SimTime limit)
+{
+    const SimTime lastKey = limit == Never ? Never : 2 * limit + 1;
+    for (;;) {
+        const SimTime arrivalKey = arrivalCursor < arrivalOrder.size() ? 2 * store.arrivalTime[arrivalOrder[arrivalCursor]] : Never;
+        const SimTime timerKey = timers.empty() ? Never : timers.topKey();
+
+        // Arrivals go first so they are queued before the tick's dispatches
+        if (arrivalKey <= timerKey) {
+            if (arrivalKey == Never || arrivalKey > lastKey) {
+                break;
+            }
+            admitArrivals<Policy>(arrivalKey / 2);
+            continue;
+        }
+        if (timerKey > lastKey) {
+            break;
+        }
+
+        const int core = timers.topCore();
+        timers.remove(core);
+        if (timerKey % 2 != 0) {
+            finishCore<Policy>(core);
+        } else {
+            runCore<Policy>(core, timerKey / 2);
+        }
+    }
+}
@@ -0,0 +1,486 @@
+#ifndef SCHEDULERENGINE_H
+#define SCHEDULERENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "latencyhistogram.h"
+#include "readyqueue.h"
+
+using SimTime = std::int64_t;
+
+enum class ProcessStatus : std::uint8_t {
+    Waiting,
+    Running,
+    Completed
+};
+
+inline const char *processStatusName(ProcessStatus status)
+{
+    switch (status) {
+    case ProcessStatus::Running:
+        return "Running";
+    case ProcessStatus::Completed:
+        return "Completed";
+    default:
+        return "Waiting";
+    }
+}
+
+// Lower Priority values are served first by the priority policies
+enum class SchedulingPolicy : std::uint8_t {
+    Fcfs,
+    ShortestJobFirst,
+    ShortestRemainingTime,
+    RoundRobin,
+    Priority,
+    PreemptivePriority
+};
+
+const int SchedulingPolicyCount = 6;
+
+// Most cores a run may simulate, as the window's core count allows
+const int MaxCoreCount = 256;
+
+inline const char *schedulingPolicyName(SchedulingPolicy policy)
+{
+    switch (policy) {
+    case SchedulingPolicy::ShortestJobFirst:
+        return "Shortest Job First";
+    case SchedulingPolicy::ShortestRemainingTime:
+        return "Shortest Remaining Time First";
+    case SchedulingPolicy::RoundRobin:
+        return "Round Robin";
+    case SchedulingPolicy::Priority:
+        return "Priority";
+    case SchedulingPolicy::PreemptivePriority:
+        return "Preemptive Priority";
+    default:
+        return "First Come First Serve";
+    }
+}
+
+// Short name used on the command line and in file names
+inline const char *schedulingPolicyKey(SchedulingPolicy policy)
+{
+    switch (policy) {
+    case SchedulingPolicy::ShortestJobFirst:
+        return "sjf";
+    case SchedulingPolicy::ShortestRemainingTime:
+        return "srtf";
+    case SchedulingPolicy::RoundRobin:
+        return "rr";
+    case SchedulingPolicy::Priority:
+        return "priority";
+    case SchedulingPolicy::PreemptivePriority:
+        return "ppriority";
+    default:
+        return "fcfs";
+    }
+}
+
+// Column-oriented process storage shared by the engine and its front ends.
+// Start and completion times are -1 until the process is dispatched/completed.
+struct ProcessStore
+{
+    std::vector<int> id;
+    std::vector<SimTime> arrivalTime;
+    std::vector<int> burstTime;
+    std::vector<int> priority;
+    std::vector<SimTime> startTime;
+    std::vector<SimTime> completionTime;
+    std::vector<ProcessStatus> status;
+
+    // Every process needs at least one tick of CPU time; loaders reject the rest
+    static bool isValidBurstTime(std::int64_t burst) { return burst > 0; }
+
+    int size() const { return static_cast<int>(id.size()); }
+    bool isEmpty() const { return id.empty(); }
+
+    void reserve(int count);
+    void append(int processId, SimTime arrival, int burst, int processPriority);
+    // Removes every process with marked[index] set in one pass, keeping the
+    // order of the rest; returns how many went
+    int removeMarked(const std::vector<char> &marked);
+    void clear();
+    void resetResults();
+
+    SimTime turnaroundTime(int index) const { return completionTime[index] - arrivalTime[index]; }
+    SimTime waitingTime(int index) const { return turnaroundTime(index) - burstTime[index]; }
+    SimTime responseTime(int index) const { return startTime[index] - arrivalTime[index]; }
+};
+
+// One uninterrupted stretch of CPU time. Covers ticks [start, end]; end is -1
+// while the process is still running.
+struct ExecutionSegment
+{
+    int process;
+    SimTime start;
+    SimTime end;
+};
+
+// What a replica needs to catch up with an engine running on another thread:
+// the processes that changed since the previous frame, the state of every
+// core, the segments that were added or closed and the history buckets that
+// grew. Frames are applied in the order they were published.
+struct ProcessUpdate
+{
+    int index;
+    ProcessStatus status;
+    int core;
+    int remaining;
+    SimTime startTime;
+    SimTime completionTime;
+};
+
+// Segments [firstSegment, firstSegment + segmentCount) of the core replace the
+// replica's from firstSegment on; they are stored back to back in SimulationFrame::segments.
+struct CoreUpdate
+{
+    int running;
+    SimTime runningEnd;
+    SimTime segmentStart;
+    SimTime closedBusy;
+    std::size_t firstSegment;
+    std::size_t segmentCount;
+};
+
+struct SimulationFrame
+{
+    SimTime time = 0;
+    int completed = 0;
+    int queued = 0;
+    int runningCores = 0;
+    SimTime runningStartSum = 0;
+    std::int64_t events = 0;
+    SimTime turnaroundSum = 0;
+    SimTime waitingSum = 0;
+    SimTime responseSum = 0;
+    std::int64_t turnaroundMax = 0;
+    std::int64_t waitingMax = 0;
+    std::int64_t responseMax = 0;
+    SimTime closedBusy = 0;
+    std::vector<ProcessUpdate> processes;
+    std::vector<CoreUpdate> cores;
+    std::vector<ExecutionSegment> segments;
+    SimTime historyInterval = 1;
+    std::size_t firstHistoryBucket = 0;
+    std::vector<SimTime> history;
+    std::vector<SimTime> completions;
+};
+
+class EventJournal;
+class TraceWriter;
+
+// Discrete-event scheduler. Time is measured in the same unit ticks as the
+// original timer-driven loop (the first tick is 1, a process dispatched at tick
+// s with burst b completes at tick s + b - 1), but the engine jumps straight
+// from one arrival/dispatch/preemption/completion to the next instead of
+// visiting every tick.
+//
+// Each scheduling policy is a compile-time parameter of the event loop, so its
+// queueing and preemption decisions are inlined. A preempted process has run
+// up to the tick before the one its successor is dispatched in; Round Robin
+// requeues the running process behind the arrivals of the tick its quantum
+// expires in, and keeps it running if nothing else is ready.
+//
+// With several cores every core has its own ready queue. An arrival goes to
+// the core that went idle most recently, or round robin over the cores when
+// none is idle; preemption and quanta only look at the core's own queue. With
+// work stealing an idle core takes the best waiting process of a random core
+// that has work queued behind its running process. Cores only wake up for
+// their own events, so no event scans the cores.
+class SchedulerEngine
+{
+public:
+    SchedulerEngine();
+
+    ProcessStore &processes() { return store; }
+    const ProcessStore &processes() const { return store; }
+
+    // Policy and Round Robin quantum for the next reset()
+    void setPolicy(SchedulingPolicy policy, SimTime quantum = 4);
+    SchedulingPolicy policy() const { return selectedPolicy; }
+    SimTime timeQuantum() const { return selectedQuantum; }
+
+    // Core count and load balancing for the next reset()
+    void setCoreCount(int count);
+    void setWorkStealing(bool enabled) { selectedStealing = enabled; }
+    bool workStealing() const { return selectedStealing; }
+
+    // Clears all results and rewinds the clock to 0
+    void reset();
+
+    // Processes every event up to and including tick `time`. Once every
+    // process has completed the clock stays at the last completion.
+    void advanceTo(SimTime time);
+
+    // Runs until every process has completed; the clock stops at the last completion
+    void run();
+
+    SimTime currentTime() const { return now; }
+    bool isFinished() const { return completed == store.size(); }
+    int coreCount() const { return static_cast<int>(cores.size()); }
+    int runningIndex(int core = 0) const { return cores[core].running; }
+    int runningCount() const { return runningCores; }
+    int readyCount() const { return queued; }
+    int completedCount() const { return completed; }
+    std::int64_t eventCount() const { return events; }
+    SimTime remainingTime(int index) const;
+
+    // Core a process was last queued on or ran on, -1 before it arrives
+    int coreOf(int index) const { return processCore[index]; }
+
+    // Running totals over completed processes
+    SimTime totalTurnaroundTime() const { return turnaroundSum; }
+    SimTime totalWaitingTime() const { return waitingSum; }
+    SimTime totalResponseTime() const { return responseSum; }
+
+    // Distributions over completed processes, updated as they complete
+    const LatencyHistogram &turnaroundHistogram() const { return turnaroundTimes; }
+    const LatencyHistogram &waitingHistogram() const { return waitingTimes; }
+    const LatencyHistogram &responseHistogram() const { return responseTimes; }
+
+    // CPU accounting over [0, currentTime()), summed over all cores. A process
+    // keeps its core busy from its start tick up to, but not including, its
+    // completion tick, which is how the simulator has always computed
+    // utilisation; a preempted stretch counts every tick it ran.
+    SimTime busyTime() const { return closedBusy + runningCores * now - runningStartSum; }
+    SimTime idleTime() const { return coreCount() * now - busyTime(); }
+    SimTime coreBusyTime(int core) const;
+
+    // Busy time (summed over all cores) and completions per [k * interval,
+    // (k + 1) * interval) window; a span is added once its process leaves the
+    // CPU. Each run starts with the interval set here (1 tick by default). The
+    // history never holds more than 4096 windows: when the run outgrows them,
+    // neighbouring windows are merged and the interval doubles, so the whole
+    // run stays covered at a coarser resolution in fixed memory. Changing the
+    // interval clears the history.
+    void setHistoryInterval(SimTime interval);
+    SimTime historyInterval() const { return intervalLength; }
+    const std::vector<SimTime> &busyHistory() const { return history; }
+    const std::vector<SimTime> &completionHistory() const { return completions; }
+
+    // Execution segments of one core in dispatch order; a preempted process
+    // gets a new segment each time it is dispatched. Segments on one core never
+    // overlap, so the list is sorted by both start and end and can be binary
+    // searched. Recording can only be switched between runs, before reset().
+    void setRecordSegments(bool enabled) { recordSegments = enabled; }
+    const std::vector<ExecutionSegment> &segments(int core = 0) const { return cores[core].segments; }
+
+    // Checkpoints for seeking. With an interval set (before reset()), the
+    // engine saves its state every interval ticks as it simulates: the cores,
+    // their ready queues and the processes in flight, plus the history.
+    // Completed processes are journalled once, in completion order, rather
+    // than in every checkpoint. When the checkpoints outgrow 1024 entries or
+    // 64 MiB, every other one is dropped and the interval doubles, like the
+    // history. 0 (the default) switches them off.
+    void setCheckpointInterval(SimTime interval);
+    SimTime checkpointInterval() const { return checkpointSpacing; }
+    int checkpointCount() const { return static_cast<int>(checkpoints.size()); }
+    std::size_t checkpointMemory() const { return checkpointBytes; }
+
+    // Moves the clock to time and leaves the engine as if it had run from 0
+    // to there. Backwards, or forwards past a checkpoint ahead of the clock,
+    // it restores the latest checkpoint at or before time and simulates the
+    // rest, so a seek costs at most one checkpoint interval of simulation plus
+    // the processes that changed in between, however long the run. Without
+    // checkpoints it can only go forwards. A publishing engine's next frame
+    // brings its replicas along.
+    void seekTo(SimTime time);
+
+    // Indices of processes whose status changed during the last advanceTo()/run()/seekTo()
+    // or the last applied frame
+    const std::vector<int> &changedIndices() const { return changed; }
+
+    // Policy, cores, history interval and segment recording of other, for the next reset()
+    void copySettings(const SchedulerEngine &other);
+
+    // Replication. An engine with publishing switched on (before reset())
+    // fills frames with what changed since its previous frame; a replica
+    // holding the same processes and settings, reset at the same time, applies
+    // them in order and then answers every query the same way.
+    void setPublishing(bool enabled) { publishing = enabled; }
+    void publishFrame(SimulationFrame &frame);
+    void applyFrame(const SimulationFrame &frame);
+
+    // Streams every execution segment and ready queue change to writer while
+    // simulating (see TraceWriter); nullptr switches tracing off. Not part of
+    // the settings that copySettings() copies.
+    void setTrace(TraceWriter *writer) { trace = writer; }
+
+    // Records every arrival, dispatch, preemption and completion in recorder
+    // while simulating (see EventJournal), for replaying the run without
+    // simulating it again; nullptr switches it off. Journals cover runs
+    // forwards from reset(), without seeks. Not copied by copySettings().
+    void setJournal(EventJournal *recorder) { journal = recorder; }
+
+private:
+    struct Core
+    {
+        FifoReadyQueue fifoQueue;
+        KeyedReadyQueue keyedQueue;
+        int running = -1;
+        SimTime runningEnd = -1;
+        SimTime segmentStart = 0;
+        SimTime sliceStart = 0;
+        SimTime sliceEnd = 0;
+        SimTime freeAt = 1;
+        SimTime closedBusy = 0;
+        int loadedSlot = -1;
+        bool touched = false;
+        std::vector<ExecutionSegment> segments;
+        // Segments a seek went back past, latest first, the last one being
+        // segment number rewoundStart; simulating forwards recreates them
+        std::vector<ExecutionSegment> rewoundSegments;
+        std::size_t rewoundStart = 0;
+
+        bool queueEmpty() const { return fifoQueue.empty() && keyedQueue.empty(); }
+    };
+
+    struct CoreCheckpoint
+    {
+        int running;
+        SimTime runningEnd;
+        SimTime segmentStart;
+        SimTime sliceStart;
+        SimTime sliceEnd;
+        SimTime freeAt;
+        SimTime closedBusy;
+        int loadedSlot;
+        std::size_t segmentCount;
+        std::vector<int> fifoQueue;
+        KeyedReadyQueue keyedQueue;
+    };
+
+    // A process that has arrived but not completed
+    struct ProcessCheckpoint
+    {
+        int index;
+        ProcessStatus status;
+        int core;
+        int remaining;
+        SimTime startTime;
+    };
+
+    // The engine after every event up to and including tick `time`, less
+    // what the process list, the completion journal and the segments hold
+    struct Checkpoint
+    {
+        SimTime time;
+        std::size_t arrivalCursor;
+        int nextPlacement;
+        std::uint64_t stealState;
+        int runningCores;
+        SimTime runningStartSum;
+        int queued;
+        int completed;
+        std::int64_t events;
+        SimTime turnaroundSum;
+        SimTime waitingSum;
+        SimTime responseSum;
+        std::int64_t turnaroundMax;
+        std::int64_t waitingMax;
+        std::int64_t responseMax;
+        SimTime closedBusy;
+        SimTime intervalLength;
+        std::vector<SimTime> history;
+        std::vector<SimTime> completions;
+        std::vector<CoreCheckpoint> cores;
+        CoreTimerQueue timers;
+        std::vector<int> idleCores;
+        std::vector<int> loadedCores;
+        std::vector<ProcessCheckpoint> processes;
+        std::size_t bytes;
+    };
+
+    struct CompletionRecord
+    {
+        int index;
+        int core;
+        SimTime startTime;
+        SimTime completionTime;
+    };
+
+    ProcessStore store;
+    std::vector<int> arrivalOrder;
+    std::size_t arrivalCursor;
+    std::vector<int> remainingWork;
+    std::vector<int> processCore;
+    SchedulingPolicy selectedPolicy;
+    SimTime selectedQuantum;
+    int selectedCores;
+    bool selectedStealing;
+    SchedulingPolicy activePolicy;
+    SimTime quantum;
+    bool stealing;
+    std::vector<Core> cores;
+    CoreTimerQueue timers;
+    std::vector<int> idleCores;
+    std::vector<int> loadedCores;
+    std::vector<int> touchedCores;
+    int nextPlacement;
+    std::uint64_t stealState;
+    SimTime now;
+    int runningCores;
+    SimTime runningStartSum;
+    int queued;
+    int completed;
+    std::int64_t events;
+    std::vector<int> changed;
+    SimTime turnaroundSum;
+    SimTime waitingSum;
+    SimTime responseSum;
+    LatencyHistogram turnaroundTimes;
+    LatencyHistogram waitingTimes;
+    LatencyHistogram responseTimes;
+    SimTime closedBusy;
+    SimTime selectedInterval;
+    SimTime intervalLength;
+    std::vector<SimTime> history;
+    std::vector<SimTime> completions;
+    std::size_t historyDirty;
+    bool recordSegments;
+    bool publishing;
+    std::vector<int> unpublished;
+    std::vector<char> unpublishedMark;
+    std::vector<std::size_t> publishedSegments;
+    SimTime selectedCheckpointSpacing;
+    SimTime checkpointSpacing;
+    std::vector<Checkpoint> checkpoints;
+    std::size_t checkpointBytes;
+    std::vector<CompletionRecord> completionJournal;
+    TraceWriter *trace;
+    EventJournal *journal;
+
+    void advance(SimTime time);
+    void simulate(SimTime limit);
+    template <typename Policy> void processEvents(SimTime limit);
+    template <typename Policy> void admitArrivals(SimTime time);
+    template <typename Policy> void runCore(int core, SimTime time);
+    template <typename Policy> void finishCore(int core);
+    template <typename Policy> void makeReady(int core, int index);
+    template <typename Policy> int takeReady(int core);
+    template <typename Policy> bool steal(int core);
+    template <typename Policy> void dispatch(int core, SimTime time);
+    void preempt(int core, SimTime time);
+    void complete(int core);
+    void armTimer(int core);
+    void updateLoaded(int core);
+    void wakeIdleCore(SimTime time);
+    void addBusySpan(Core &core, SimTime begin, SimTime end);
+    std::size_t historyBucket(SimTime time);
+    void mergeHistory();
+    void collectUnpublished();
+    SimTime nextEventTime() const;
+    SimTime nextCheckpointTime() const;
+    void saveCheckpoint(SimTime time);
+    void thinCheckpoints();
+    void restoreCheckpoint(const Checkpoint &checkpoint);
+    void clearProcess(int index);
+    void restoreSegments(Core &core, std::size_t count);
+    static void dropReplayedSegments(Core &core);
+};
+
+#endif // SCHEDULERENGINE_H
@@ -0,0 +1,203 @@
+#include "simulationworker.h"
+
+#include <algorithm>
+
+SimulationWorker::SimulationWorker()
+    : spare(&frames[0])
+    , mailbox(nullptr)
+    , released(&frames[1])
+    , publishedTime(0)
+    , stopRequested(false)
+    , interval(0)
+    , fastForward(false)
+    , toEnd(false)
+    , timing(false)
+    , workTime(0)
+{
+}
+
+SimulationWorker::~SimulationWorker()
+{
+    stop();
+}
+
+void SimulationWorker::load(const SchedulerEngine &source)
+{
+    stop();
+    engine.processes() = source.processes();
+    engine.copySettings(source);
+    engine.setPublishing(true);
+    engine.reset();
+    publishedTime = 0;
+
+    // Frames of the previous run no longer apply
+    spare = &frames[0];
+    mailbox.store(nullptr);
+    released.store(&frames[1]);
+}
+
+void SimulationWorker::start(int intervalMs)
+{
+    stop();
+    interval = std::max(intervalMs, 0);
+    toEnd = false;
+    stopRequested = false;
+    thread = std::thread(&SimulationWorker::run, this);
+}
+
+void SimulationWorker::runToEnd()
+{
+    stop();
+    toEnd = true;
+    stopRequested = false;
+    thread = std::thread(&SimulationWorker::run, this);
+}
+
+void SimulationWorker::seek(SimTime time)
+{
+    stop();
+    engine.seekTo(time);
+    // Even a seek back to the published time has changes to send
+    publishedTime = -1;
+}
+
+void SimulationWorker::setFastForward(bool enabled)
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        fastForward = enabled;
+    }
+    wake.notify_all();
+}
+
+void SimulationWorker::setInterval(int intervalMs)
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        interval = std::max(intervalMs, 0);
+    }
+    wake.notify_all();
+}
+
+void SimulationWorker::stop()
+{
+    if (!thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopRequested = true;
+    }
+    wake.notify_all();
+    thread.join();
+}
+
+SimulationFrame *SimulationWorker::takeFrame()
+{
+    SimulationFrame *frame = mailbox.exchange(nullptr, std::memory_order_acquire);
+    if (!frame && !thread.joinable() && publishedTime != engine.currentTime()) {
+        // The thread is gone, so the engine is ours to publish from
+        publish();
+        frame = mailbox.exchange(nullptr, std::memory_order_acquire);
+    }
+    return frame;
+}
+
+void SimulationWorker::releaseFrame(SimulationFrame *frame)
+{
+    released.store(frame, std::memory_order_release);
+}
+
+bool SimulationWorker::publish()
+{
+    if (!spare) {
+        spare = released.exchange(nullptr, std::memory_order_acquire);
+    }
+    if (!spare || mailbox.load(std::memory_order_acquire)) {
+        return false;
+    }
+    engine.publishFrame(*spare);
+    publishedTime = engine.currentTime();
+    mailbox.store(spare, std::memory_order_release);
+    spare = nullptr;
+    return true;
+}
+
+void SimulationWorker::run()
+{
+    std::chrono::steady_clock::time_point lastTick = std::chrono::steady_clock::now();
+    SimTime stride = 1;
+    while (!engine.isFinished()) {
+        if (toEnd || fastForward) {
+            if (stopRequested) {
+                return;
+            }
+            stride = advanceSlice(stride);
+            if (!toEnd) {
+                publish();
+            }
+            // Back at a normal speed, the next tick is one interval away
+            lastTick = std::chrono::steady_clock::now();
+            continue;
+        }
+        sleepUntilNextTick(lastTick);
+        if (stopRequested) {
+            return;
+        }
+        if (timing.load(std::memory_order_relaxed)) {
+            const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+            engine.advanceTo(engine.currentTime() + 1);
+            addWorkTime(std::chrono::steady_clock::now() - begin);
+        } else {
+            engine.advanceTo(engine.currentTime() + 1);
+        }
+        publish();
+    }
+
+    // The final frame has to get through before the thread ends
+    while (publishedTime != engine.currentTime() && !publish() && !stopRequested) {
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait_for(lock, std::chrono::milliseconds(1));
+    }
+}
+
+SimTime SimulationWorker::advanceSlice(SimTime stride)
+{
+    // The engine jumps between events, so a slice of many ticks can cost no
+    // more than one; the stride follows whatever keeps a slice near 1 ms
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point begin = Clock::now();
+    engine.advanceTo(engine.currentTime() + stride);
+    const Clock::duration elapsed = Clock::now() - begin;
+    if (timing.load(std::memory_order_relaxed)) {
+        addWorkTime(elapsed);
+    }
+    if (elapsed < std::chrono::microseconds(500)) {
+        return stride < (SimTime(1) << 40) ? stride * 2 : stride;
+    }
+    if (elapsed > std::chrono::milliseconds(2)) {
+        return std::max<SimTime>(stride / 2, 1);
+    }
+    return stride;
+}
+
+void SimulationWorker::addWorkTime(std::chrono::steady_clock::duration elapsed)
+{
+    workTime.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                       std::memory_order_relaxed);
+}
+
+void SimulationWorker::sleepUntilNextTick(std::chrono::steady_clock::time_point &lastTick)
+{
+    using Clock = std::chrono::steady_clock;
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    Clock::time_point deadline = lastTick + std::chrono::milliseconds(interval);
+    // A new interval applies to the tick being waited for, as with QTimer::setInterval()
+    while (!stopRequested && !fastForward && Clock::now() < deadline) {
+        wake.wait_until(lock, deadline);
+        deadline = lastTick + std::chrono::milliseconds(interval);
+    }
+    // A tick that ran long delays the next one rather than causing a burst
+    const Clock::time_point woken = Clock::now();
+    lastTick = woken - deadline > std::chrono::milliseconds(interval) ? woken : deadline;
+}
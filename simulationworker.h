@@ -0,0 +1,88 @@
+#ifndef SIMULATIONWORKER_H
+#define SIMULATIONWORKER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "schedulerengine.h"
+
+// Runs a SchedulerEngine on its own thread, one tick per interval like the
+// old GUI timer, and hands what changed to one consumer thread as
+// SimulationFrames. The handoff is a single-slot mailbox of two frames
+// swapped with atomic exchanges: the worker only publishes into an empty
+// slot, and until the consumer takes the previous frame the changes pile up
+// in the engine, so nothing is lost and neither side ever waits for the other.
+//
+// Everything except takeFrame()/releaseFrame() belongs to the consumer thread.
+class SimulationWorker
+{
+public:
+    SimulationWorker();
+    ~SimulationWorker();
+
+    // Copies the processes and settings of source and rewinds to time 0.
+    // Only while stopped.
+    void load(const SchedulerEngine &source);
+
+    // Ticks every intervalMs milliseconds from the current time until stop()
+    // or the last completion; the first tick follows one interval after start()
+    void start(int intervalMs);
+    void setInterval(int intervalMs);
+
+    // Instead of ticking, advances in slices of about a millisecond of work as
+    // fast as the engine goes. Frames still only go out as they are taken, so
+    // the consumer decides how often it refreshes. Can be switched while running.
+    void setFastForward(bool enabled);
+
+    // Fast-forwards to the last completion and publishes only the final state
+    void runToEnd();
+
+    // Moves the engine to time (see SchedulerEngine::seekTo()); the next
+    // takeFrame() brings the consumer's replica along. Only while stopped.
+    void seek(SimTime time);
+
+    void stop();
+    bool isRunning() const { return thread.joinable(); }
+
+    // Adds up the time the thread spends in the engine, for the profiler
+    void setTimingEnabled(bool enabled) { timing.store(enabled, std::memory_order_relaxed); }
+    // Engine time in nanoseconds since the previous call
+    std::int64_t takeWorkTime() { return workTime.exchange(0, std::memory_order_relaxed); }
+
+    // The oldest unconsumed frame or nullptr. Once stopped, this also
+    // publishes whatever the thread had not handed over yet. Every frame taken
+    // has to be given back with releaseFrame() after it has been applied.
+    SimulationFrame *takeFrame();
+    void releaseFrame(SimulationFrame *frame);
+
+private:
+    SchedulerEngine engine;
+    SimulationFrame frames[2];
+    SimulationFrame *spare;
+    std::atomic<SimulationFrame *> mailbox;
+    std::atomic<SimulationFrame *> released;
+    SimTime publishedTime;
+
+    std::thread thread;
+    std::atomic<bool> stopRequested;
+    std::atomic<int> interval;
+    std::atomic<bool> fastForward;
+    bool toEnd;
+    std::atomic<bool> timing;
+    std::atomic<std::int64_t> workTime;
+    // Only for sleeping between ticks, so stop() and setInterval() can cut a sleep short
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+    void run();
+    bool publish();
+    void sleepUntilNextTick(std::chrono::steady_clock::time_point &deadline);
+    SimTime advanceSlice(SimTime stride);
+    void addWorkTime(std::chrono::steady_clock::duration elapsed);
+};
+
+#endif // SIMULATIONWORKER_H
@@ -0,0 +1,541 @@
+// SimulatorBench: times the simulator's hot paths on generated workloads of
+// several sizes and prints one CSV row per benchmark and size. With
+// --baseline it compares against an earlier run's output and exits with 1
+// when anything got slower than the threshold allows.
+//
+//   SimulatorBench --sizes 1000,10000,100000,1000000,10000000 --out bench.csv
+//   SimulatorBench --baseline bench.csv --threshold 10
+
+#include "chartsummary.h"
+#include "eventjournal.h"
+#include "ganttchartview.h"
+#include "processindex.h"
+#include "processtablemodel.h"
+#include "schedulerengine.h"
+#include "workloadgenerator.h"
+#include "workloadio.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QHeaderView>
+#include <QImage>
+#include <QLabel>
+#include <QProgressBar>
+#include <QScrollBar>
+#include <QTableView>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+// One timed repetition. Events are simulation events for the simulation
+// benchmarks and display refreshes for the widget ones; rows are the process
+// rows the repetition went through.
+struct Sample
+{
+    qint64 nanoseconds = 0;
+    qint64 events = 0;
+    qint64 rows = 0;
+};
+
+struct BenchResult
+{
+    QString name;
+    int size = 0;
+    int repetitions = 0;
+    Sample best;
+};
+
+struct BenchContext
+{
+    int size;
+    ProcessStore workload;
+    QString directory;
+};
+
+using Benchmark = std::function<Sample(BenchContext &)>;
+
+// Repeats body until minimumNs has passed (at least once) and keeps the fastest repetition
+static BenchResult measure(const QString &name, BenchContext &context, qint64 minimumNs, const Benchmark &body)
+{
+    BenchResult result;
+    result.name = name;
+    result.size = context.size;
+    qint64 spent = 0;
+    do {
+        const Sample sample = body(context);
+        if (result.repetitions == 0 || sample.nanoseconds < result.best.nanoseconds) {
+            result.best = sample;
+        }
+        ++result.repetitions;
+        spent += sample.nanoseconds;
+    } while (spent < minimumNs && result.repetitions < 1000);
+    return result;
+}
+
+// About 80% load on one core: mean burst 4, one arrival every 5 ticks
+static WorkloadSpec benchWorkload(int size)
+{
+    WorkloadSpec spec;
+    spec.count = size;
+    spec.seed = 20240601;
+    spec.arrivalRate = 0.2;
+    spec.meanBurst = 4.0;
+    return spec;
+}
+
+static Sample simulate(const ProcessStore &workload, SchedulingPolicy policy, int cores, bool stealing)
+{
+    SchedulerEngine engine;
+    engine.processes() = workload;
+    engine.setPolicy(policy, 4);
+    engine.setCoreCount(cores);
+    engine.setWorkStealing(stealing);
+    engine.setRecordSegments(false);
+
+    QElapsedTimer timer;
+    timer.start();
+    engine.reset();
+    engine.run();
+    return {timer.nsecsElapsed(), engine.eventCount(), workload.size()};
+}
+
+// A finished FCFS run with segments, for the export and widget benchmarks
+static void runToCompletion(SchedulerEngine &engine, const ProcessStore &workload)
+{
+    engine.processes() = workload;
+    engine.reset();
+    engine.run();
+}
+
+static Sample benchGenerate(BenchContext &context)
+{
+    ProcessStore store;
+    QElapsedTimer timer;
+    timer.start();
+    generateWorkload(benchWorkload(context.size), store);
+    return {timer.nsecsElapsed(), 0, store.size()};
+}
+
+static QByteArray workloadCsv(const ProcessStore &store)
+{
+    QByteArray csv = "ID,ArrivalTime,BurstTime,Priority\n";
+    csv.reserve(store.size() * 24);
+    char line[96];
+    for (int i = 0; i < store.size(); ++i) {
+        const int length = std::snprintf(line, sizeof(line), "%d,%lld,%d,%d\n", store.id[i],
+                                         static_cast<long long>(store.arrivalTime[i]), store.burstTime[i], store.priority[i]);
+        csv.append(line, length);
+    }
+    return csv;
+}
+
+static Sample benchCsvParse(BenchContext &context)
+{
+    const QByteArray csv = workloadCsv(context.workload);
+    ProcessStore store;
+    QElapsedTimer timer;
+    timer.start();
+    const CsvParseResult result = parseWorkloadCsv(csv.constData(), static_cast<std::size_t>(csv.size()), store);
+    return {timer.nsecsElapsed(), 0, result.rowCount};
+}
+
+static Sample benchCsvImport(BenchContext &context)
+{
+    const QString fileName = context.directory + "/import.csv";
+    QFile file(fileName);
+    if (!file.exists() && file.open(QIODevice::WriteOnly)) {
+        file.write(workloadCsv(context.workload));
+        file.close();
+    }
+    ProcessStore store;
+    QElapsedTimer timer;
+    timer.start();
+    loadWorkloadCsv(fileName, store);
+    return {timer.nsecsElapsed(), 0, store.size()};
+}
+
+static Sample benchCsvExport(BenchContext &context)
+{
+    SchedulerEngine engine;
+    engine.setRecordSegments(false);
+    runToCompletion(engine, context.workload);
+    QElapsedTimer timer;
+    timer.start();
+    writeResultsCsv(context.directory + "/export.csv", engine.processes(), engine.currentTime());
+    return {timer.nsecsElapsed(), 0, engine.processes().size()};
+}
+
+static Sample benchBinaryExport(BenchContext &context)
+{
+    QElapsedTimer timer;
+    timer.start();
+    writeWorkloadBinary(context.directory + "/workload.simbin", context.workload, 0, false);
+    return {timer.nsecsElapsed(), 0, context.workload.size()};
+}
+
+static Sample benchBinaryImport(BenchContext &context)
+{
+    const QString fileName = context.directory + "/workload.simbin";
+    if (!QFile::exists(fileName)) {
+        writeWorkloadBinary(fileName, context.workload, 0, false);
+    }
+    ProcessStore store;
+    QElapsedTimer timer;
+    timer.start();
+    loadWorkloadBinary(fileName, store);
+    return {timer.nsecsElapsed(), 0, store.size()};
+}
+
+// An FCFS run to completion that records its event journal
+static Sample benchJournalWrite(BenchContext &context)
+{
+    SchedulerEngine engine;
+    engine.processes() = context.workload;
+    engine.setRecordSegments(false);
+    EventJournal journal;
+    engine.setJournal(&journal);
+
+    QElapsedTimer timer;
+    timer.start();
+    engine.reset();
+    journal.open(QFile::encodeName(context.directory + "/run.simlog").toStdString(), engine.coreCount(), engine.processes().size());
+    engine.run();
+    journal.close();
+    return {timer.nsecsElapsed(), journal.eventCount(), context.workload.size()};
+}
+
+// The results of that run rebuilt from its journal
+static Sample benchJournalReplay(BenchContext &context)
+{
+    const QString fileName = context.directory + "/run.simlog";
+    if (!QFile::exists(fileName)) {
+        benchJournalWrite(context);
+    }
+    ProcessStore store = context.workload;
+    JournalReplay replay;
+    QElapsedTimer timer;
+    timer.start();
+    replayJournal(QFile::encodeName(fileName).toStdString(), store, std::numeric_limits<SimTime>::max(), nullptr, &replay);
+    return {timer.nsecsElapsed(), replay.events, store.size()};
+}
+
+// The process list's bulk edits: index it, remove every other process, edit
+// the rest and append the removed ones again, duplicates included
+static Sample benchBulkEdit(BenchContext &context)
+{
+    ProcessStore store = context.workload;
+    std::vector<int> rows;
+    for (int slot = 0; slot < store.size(); slot += 2) {
+        rows.push_back(slot / 2);
+    }
+    ProcessIndex index;
+    ProcessEdit edit;
+    edit.priority = 1;
+
+    QElapsedTimer timer;
+    timer.start();
+    index.rebuild(store);
+    const int removed = removeProcessesIf(store, index, [](const ProcessStore &, int slot) {
+        return slot % 2 == 1;
+    });
+    editProcesses(store, rows, edit);
+    appendProcesses(store, index, context.workload);
+    const qint64 touched = removed + static_cast<qint64>(rows.size()) + context.workload.size();
+    return {timer.nsecsElapsed(), touched, store.size()};
+}
+
+// What the window does per refresh: the worker publishes what changed, the
+// window's replica applies it. About a thousand frames per run.
+static Sample benchSimulationStep(BenchContext &context)
+{
+    SchedulerEngine worker;
+    worker.processes() = context.workload;
+    worker.setPublishing(true);
+    worker.reset();
+    SchedulerEngine replica;
+    replica.processes() = context.workload;
+    replica.reset();
+
+    const SimTime stride = std::max<SimTime>(context.workload.arrivalTime.back() / 1000, 1);
+    SimulationFrame frame;
+    QElapsedTimer timer;
+    timer.start();
+    while (!replica.isFinished()) {
+        worker.advanceTo(worker.currentTime() + stride);
+        worker.publishFrame(frame);
+        replica.applyFrame(frame);
+    }
+    return {timer.nsecsElapsed(), worker.eventCount(), context.workload.size()};
+}
+
+// updateSimulationStats(): counters turned into label texts
+static Sample benchUpdateSimulationStats(BenchContext &context)
+{
+    SchedulerEngine engine;
+    engine.setRecordSegments(false);
+    runToCompletion(engine, context.workload);
+    QLabel progressLabel;
+    QLabel turnaroundLabel;
+    QLabel waitingLabel;
+    QProgressBar utilizationBar;
+
+    const int refreshes = 10000;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < refreshes; ++i) {
+        const int completed = engine.completedCount();
+        const SimTime now = engine.currentTime() - i;
+        progressLabel.setText(QString("Progress: %1/%2 processes completed").arg(completed).arg(engine.processes().size()));
+        utilizationBar.setValue(static_cast<int>(engine.busyTime() * 100 / std::max<SimTime>(now, 1)) % 101);
+        turnaroundLabel.setText(QString("Average Turnaround Time: %1").arg(static_cast<double>(engine.totalTurnaroundTime()) / completed, 0, 'f', 2));
+        waitingLabel.setText(QString("Average Waiting Time: %1").arg(static_cast<double>(engine.totalWaitingTime()) / completed, 0, 'f', 2));
+    }
+    return {timer.nsecsElapsed(), refreshes, 0};
+}
+
+// updatePerformanceCharts(): the pass that picks what the per-process charts show
+static Sample benchSummarizeProcesses(BenchContext &context)
+{
+    SchedulerEngine engine;
+    engine.setRecordSegments(false);
+    runToCompletion(engine, context.workload);
+
+    QElapsedTimer timer;
+    timer.start();
+    const ProcessChartSummary summary = summarizeProcesses(engine, 50, 20, 15);
+    const qint64 elapsed = timer.nsecsElapsed();
+    return {elapsed, 1, summary.completed};
+}
+
+// Timeline seeks over a finished run, scattered back and forth like a scrubbing
+// user. Each is at most one checkpoint interval of simulation.
+static Sample benchSeek(BenchContext &context)
+{
+    SchedulerEngine engine;
+    engine.setPublishing(true);
+    engine.setCheckpointInterval(1000);
+    runToCompletion(engine, context.workload);
+    const SimTime end = engine.currentTime();
+
+    const int seeks = 100;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < seeks; ++i) {
+        engine.seekTo(end * ((i * 37) % seeks) / seeks);
+    }
+    return {timer.nsecsElapsed(), seeks, 0};
+}
+
+// updateProcessTable(): a batch of changed rows is signalled and the visible part repainted
+static Sample benchUpdateProcessTable(BenchContext &context)
+{
+    SchedulerEngine engine;
+    engine.setRecordSegments(false);
+    runToCompletion(engine, context.workload);
+    ProcessTableModel model(&engine.processes());
+    QTableView view;
+    view.setAttribute(Qt::WA_DontShowOnScreen);
+    view.setModel(&model);
+    view.verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    view.resize(1000, 700);
+    view.show();
+    QImage image(view.size(), QImage::Format_ARGB32_Premultiplied);
+
+    const int refreshes = 50;
+    const int batch = std::min(1000, context.size);
+    std::vector<int> changed(batch);
+    qint64 rows = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < refreshes; ++i) {
+        const int first = static_cast<int>(static_cast<qint64>(context.size - batch) * i / refreshes);
+        for (int k = 0; k < batch; ++k) {
+            changed[k] = first + k;
+        }
+        model.refreshRows(changed);
+        view.scrollTo(model.index(first, 0));
+        view.render(&image);
+        rows += batch;
+    }
+    return {timer.nsecsElapsed(), refreshes, rows};
+}
+
+// updateGanttChart(): the view picks up the segments and repaints what is in view
+static Sample benchUpdateGanttChart(BenchContext &context)
+{
+    SchedulerEngine engine;
+    runToCompletion(engine, context.workload);
+    GanttChartView view;
+    view.setAttribute(Qt::WA_DontShowOnScreen);
+    view.setEngine(&engine);
+    view.resize(1000, 300);
+    view.show();
+    QImage image(view.size(), QImage::Format_ARGB32_Premultiplied);
+
+    const int refreshes = 50;
+    QScrollBar *scrollBar = view.horizontalScrollBar();
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < refreshes; ++i) {
+        view.refresh();
+        scrollBar->setValue(scrollBar->minimum() + (scrollBar->maximum() - scrollBar->minimum()) * i / refreshes);
+        view.render(&image);
+    }
+    return {timer.nsecsElapsed(), refreshes, 0};
+}
+
+static QString csvRow(const BenchResult &result)
+{
+    const Sample &sample = result.best;
+    return QString("%1,%2,%3,%4,%5,%6,%7,%8\n")
+        .arg(result.name)
+        .arg(result.size)
+        .arg(result.repetitions)
+        .arg(sample.events)
+        .arg(sample.rows)
+        .arg(sample.nanoseconds)
+        .arg(sample.events > 0 ? QString::number(static_cast<double>(sample.nanoseconds) / sample.events, 'f', 2) : QString())
+        .arg(sample.rows > 0 ? QString::number(static_cast<double>(sample.nanoseconds) / sample.rows, 'f', 2) : QString());
+}
+
+// benchmark/size -> nanoseconds of the best repetition
+static bool loadBaseline(const QString &fileName, QHash<QString, qint64> &baseline)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream in(&file);
+    in.readLine();
+    while (!in.atEnd()) {
+        const QStringList fields = in.readLine().split(',');
+        if (fields.size() >= 6) {
+            baseline.insert(fields[0] + "/" + fields[1], fields[5].toLongLong());
+        }
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    // The widget benchmarks paint into images, so no display is needed
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks of the simulator's hot paths");
+    parser.addHelpOption();
+    parser.addOption({"sizes", "Comma-separated workload sizes.", "list", "1000,10000,100000,1000000"});
+    parser.addOption({"filter", "Only run benchmarks whose name contains <text>.", "text"});
+    parser.addOption({"min-time", "Repeat each benchmark for at least <ms> milliseconds.", "ms", "200"});
+    parser.addOption({"out", "Write the CSV results to <file> instead of standard output.", "file"});
+    parser.addOption({"baseline", "Compare with the CSV output of an earlier run.", "file"});
+    parser.addOption({"threshold", "Allowed slowdown against the baseline in percent.", "percent", "10"});
+    parser.process(app);
+
+    std::vector<int> sizes;
+    for (const QString &size : parser.value("sizes").split(',')) {
+        bool valid = false;
+        const int value = size.trimmed().toInt(&valid);
+        if (!valid || value <= 0) {
+            err << "Invalid size " << size << "\n";
+            return 1;
+        }
+        sizes.push_back(value);
+    }
+    const qint64 minimumNs = parser.value("min-time").toLongLong() * 1000000;
+
+    // Read before running, --out may overwrite it
+    QHash<QString, qint64> baseline;
+    if (parser.isSet("baseline") && !loadBaseline(parser.value("baseline"), baseline)) {
+        err << parser.value("baseline") << ": could not read the baseline\n";
+        return 1;
+    }
+
+    std::vector<std::pair<QString, Benchmark>> benchmarks = {
+        {"generate", benchGenerate},
+        {"csv_parse", benchCsvParse},
+        {"csv_import", benchCsvImport},
+        {"csv_export", benchCsvExport},
+        {"simbin_export", benchBinaryExport},
+        {"simbin_import", benchBinaryImport},
+        {"journal_write", benchJournalWrite},
+        {"journal_replay", benchJournalReplay},
+        {"bulk_edit", benchBulkEdit},
+        {"simulation_step", benchSimulationStep},
+        {"update_simulation_stats", benchUpdateSimulationStats},
+        {"summarize_processes", benchSummarizeProcesses},
+        {"seek", benchSeek},
+        {"update_process_table", benchUpdateProcessTable},
+        {"update_gantt_chart", benchUpdateGanttChart}
+    };
+    for (int i = 0; i < SchedulingPolicyCount; ++i) {
+        const SchedulingPolicy policy = static_cast<SchedulingPolicy>(i);
+        benchmarks.push_back({QString("simulate_") + schedulingPolicyKey(policy), [policy](BenchContext &context) {
+            return simulate(context.workload, policy, 1, false);
+        }});
+    }
+    benchmarks.push_back({"simulate_rr_8cores_steal", [](BenchContext &context) {
+        return simulate(context.workload, SchedulingPolicy::RoundRobin, 8, true);
+    }});
+
+    QString output = "benchmark,size,repetitions,events,rows,total_ns,ns_per_event,ns_per_row\n";
+    std::vector<BenchResult> results;
+    for (int size : sizes) {
+        QTemporaryDir directory;
+        BenchContext context{size, ProcessStore(), directory.path()};
+        generateWorkload(benchWorkload(size), context.workload);
+        for (const auto &benchmark : benchmarks) {
+            if (parser.isSet("filter") && !benchmark.first.contains(parser.value("filter"))) {
+                continue;
+            }
+            results.push_back(measure(benchmark.first, context, minimumNs, benchmark.second));
+            output += csvRow(results.back());
+            err << benchmark.first << " " << size << ": " << results.back().best.nanoseconds / 1e6 << " ms\n";
+            err.flush();
+        }
+    }
+
+    if (parser.isSet("out")) {
+        QFile file(parser.value("out"));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            err << parser.value("out") << ": could not write results\n";
+            return 1;
+        }
+        file.write(output.toUtf8());
+    } else {
+        QTextStream(stdout) << output;
+    }
+
+    if (!parser.isSet("baseline")) {
+        return 0;
+    }
+    const double threshold = parser.value("threshold").toDouble() / 100.0;
+    int regressions = 0;
+    err << "\nbenchmark,size,baseline_ns,current_ns,change_percent\n";
+    for (const BenchResult &result : results) {
+        const qint64 before = baseline.value(result.name + "/" + QString::number(result.size), 0);
+        if (before <= 0) {
+            continue;
+        }
+        const double change = static_cast<double>(result.best.nanoseconds) / before - 1.0;
+        const bool regressed = change > threshold;
+        regressions += regressed ? 1 : 0;
+        err << result.name << "," << result.size << "," << before << "," << result.best.nanoseconds << ","
+            << QString::number(change * 100.0, 'f', 1) << (regressed ? ",REGRESSION" : "") << "\n";
+    }
+    err << regressions << " regression(s) beyond " << parser.value("threshold") << "%\n";
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,343 @@
+// SimulatorTests: regression tests for the scheduler engine library. Exits
+// with 1 and names the failing checks when anything is wrong.
+//
+//   SimulatorTests
+
+#include "csvparser.h"
+#include "latencyhistogram.h"
+#include "schedulerengine.h"
+#include "sweeprunner.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string &what)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAILED: %s\n", what.c_str());
+        ++failures;
+    }
+}
+
+// Whether a shows the same run as b: the clock, every process and every core's segments
+bool sameState(const SchedulerEngine &a, const SchedulerEngine &b)
+{
+    if (a.currentTime() != b.currentTime() || a.completedCount() != b.completedCount()) {
+        return false;
+    }
+    const ProcessStore &x = a.processes();
+    const ProcessStore &y = b.processes();
+    for (int i = 0; i < x.size(); ++i) {
+        if (x.status[i] != y.status[i] || x.startTime[i] != y.startTime[i] || x.completionTime[i] != y.completionTime[i]
+            || a.remainingTime(i) != b.remainingTime(i) || a.coreOf(i) != b.coreOf(i)) {
+            return false;
+        }
+    }
+    for (int core = 0; core < a.coreCount(); ++core) {
+        const std::vector<ExecutionSegment> &s = a.segments(core);
+        const std::vector<ExecutionSegment> &t = b.segments(core);
+        if (s.size() != t.size() || a.runningIndex(core) != b.runningIndex(core)) {
+            return false;
+        }
+        for (std::size_t k = 0; k < s.size(); ++k) {
+            if (s[k].process != t[k].process || s[k].start != t[k].start || s[k].end != t[k].end) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// The same workload and settings simulated straight from reset() to time
+bool matchesFreshRun(const SchedulerEngine &engine, SimTime time)
+{
+    SchedulerEngine fresh;
+    fresh.processes() = engine.processes();
+    fresh.copySettings(engine);
+    fresh.setCheckpointInterval(0);
+    fresh.reset();
+    fresh.advanceTo(time);
+    return sameState(engine, fresh);
+}
+
+// Start and completion tick of every process
+struct ReferenceRun
+{
+    std::vector<SimTime> start;
+    std::vector<SimTime> completion;
+};
+
+// The per-tick loop the simulator used before the discrete-event engine, on
+// one core and extended to every policy: each tick queues its arrivals,
+// reconsiders the running process, dispatches if the CPU is free and runs one
+// tick. Equal keys are served in the order they were queued.
+ReferenceRun referenceRun(const ProcessStore &store, SchedulingPolicy policy, SimTime quantum)
+{
+    const int count = store.size();
+    std::vector<int> order(count);
+    for (int i = 0; i < count; ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&store](int a, int b) { return store.arrivalTime[a] < store.arrivalTime[b]; });
+
+    ReferenceRun run;
+    run.start.assign(count, -1);
+    run.completion.assign(count, -1);
+    std::vector<SimTime> remaining(store.burstTime.begin(), store.burstTime.end());
+    auto key = [&](int index) -> SimTime {
+        switch (policy) {
+        case SchedulingPolicy::ShortestJobFirst:
+            return store.burstTime[index];
+        case SchedulingPolicy::ShortestRemainingTime:
+            return remaining[index];
+        case SchedulingPolicy::Priority:
+        case SchedulingPolicy::PreemptivePriority:
+            return store.priority[index];
+        default:
+            return 0;
+        }
+    };
+    const bool preemptive = policy == SchedulingPolicy::ShortestRemainingTime
+        || policy == SchedulingPolicy::PreemptivePriority;
+
+    std::deque<int> ready;
+    auto best = [&]() {
+        std::size_t chosen = 0;
+        for (std::size_t k = 1; k < ready.size(); ++k) {
+            if (key(ready[k]) < key(ready[chosen])) {
+                chosen = k;
+            }
+        }
+        return chosen;
+    };
+
+    int running = -1;
+    SimTime sliceStart = 0;
+    int next = 0;
+    int completed = 0;
+    for (SimTime time = 1; completed < count; ++time) {
+        while (next < count && store.arrivalTime[order[next]] <= time) {
+            ready.push_back(order[next++]);
+        }
+        if (running != -1 && !ready.empty()) {
+            const bool sliceOver = policy == SchedulingPolicy::RoundRobin && (time - sliceStart) % quantum == 0;
+            if (sliceOver || (preemptive && key(ready[best()]) < key(running))) {
+                ready.push_back(running);
+                running = -1;
+            }
+        }
+        if (running == -1 && !ready.empty()) {
+            const std::size_t chosen = best();
+            running = ready[chosen];
+            ready.erase(ready.begin() + chosen);
+            sliceStart = time;
+            if (run.start[running] == -1) {
+                run.start[running] = time;
+            }
+        }
+        if (running != -1 && --remaining[running] == 0) {
+            run.completion[running] = time;
+            running = -1;
+            ++completed;
+        }
+    }
+    return run;
+}
+
+void testMatchesPerTickReference()
+{
+    std::vector<ProcessStore> workloads(4);
+    // A textbook mix with ties on arrival, burst and priority
+    const int mix[][4] = {{1, 0, 8, 3}, {2, 1, 4, 1}, {3, 2, 9, 4}, {4, 3, 5, 2}, {5, 3, 4, 1}, {6, 10, 2, 5}};
+    for (const auto &row : mix) {
+        workloads[0].append(row[0], row[1], row[2], row[3]);
+    }
+    // Idle gaps between bursts of arrivals
+    const int gaps[][4] = {{1, 5, 3, 2}, {2, 5, 1, 1}, {3, 20, 6, 3}, {4, 21, 2, 1}, {5, 21, 2, 1}, {6, 40, 1, 4}};
+    for (const auto &row : gaps) {
+        workloads[1].append(row[0], row[1], row[2], row[3]);
+    }
+    // Arrivals on and between the quantum boundaries of a long process
+    workloads[2].append(1, 0, 20, 5);
+    for (int i = 0; i < 8; ++i) {
+        workloads[2].append(i + 2, 2 + i * 3, 1 + i % 4, i % 6);
+    }
+    std::mt19937 random(4);
+    for (int i = 0; i < 40; ++i) {
+        workloads[3].append(i + 1, random() % 60, 1 + random() % 12, random() % 5);
+    }
+
+    for (std::size_t w = 0; w < workloads.size(); ++w) {
+        for (int p = 0; p < SchedulingPolicyCount; ++p) {
+            for (const SimTime quantum : {1, 3}) {
+                const SchedulingPolicy policy = static_cast<SchedulingPolicy>(p);
+                SchedulerEngine engine;
+                engine.processes() = workloads[w];
+                engine.setPolicy(policy, quantum);
+                engine.setCheckpointInterval(0);
+                engine.reset();
+                engine.run();
+
+                const ReferenceRun expected = referenceRun(workloads[w], policy, quantum);
+                const ProcessStore &store = engine.processes();
+                bool same = engine.isFinished();
+                for (int i = 0; same && i < store.size(); ++i) {
+                    same = store.startTime[i] == expected.start[i] && store.completionTime[i] == expected.completion[i];
+                }
+                // Turnaround, waiting and response times follow from these, but compare the totals too
+                SimTime turnaround = 0;
+                SimTime waiting = 0;
+                SimTime response = 0;
+                for (int i = 0; i < store.size(); ++i) {
+                    turnaround += expected.completion[i] - store.arrivalTime[i];
+                    waiting += expected.completion[i] - store.arrivalTime[i] - store.burstTime[i];
+                    response += expected.start[i] - store.arrivalTime[i];
+                }
+                same = same && engine.totalTurnaroundTime() == turnaround && engine.totalWaitingTime() == waiting
+                    && engine.totalResponseTime() == response;
+                check(same, "per-tick reference, workload " + std::to_string(w) + " policy " + std::to_string(p)
+                          + " quantum " + std::to_string(quantum));
+            }
+        }
+    }
+}
+
+void testSeekBackPastRunningSegment()
+{
+    // Going back past a checkpoint with a process running, then forwards to it again
+    SchedulerEngine engine;
+    engine.processes().append(1, 5, 4, 1);
+    engine.setCheckpointInterval(1);
+    engine.reset();
+    engine.seekTo(6);
+    engine.seekTo(2);
+    engine.seekTo(6);
+    check(matchesFreshRun(engine, 6), "seek 6, 2, 6 with one process");
+
+    SchedulerEngine overlapping;
+    for (int i = 0; i < 200; ++i) {
+        overlapping.processes().append(i + 1, i * 50, 300, 1);
+    }
+    overlapping.setCheckpointInterval(1000);
+    overlapping.reset();
+    overlapping.seekTo(5000);
+    overlapping.seekTo(100);
+    overlapping.seekTo(5000);
+    check(matchesFreshRun(overlapping, 5000), "seek 5000, 100, 5000 with overlapping processes");
+}
+
+void testRandomSeeks()
+{
+    std::mt19937 random(9);
+    for (int run = 0; run < 500; ++run) {
+        SchedulerEngine engine;
+        const int count = 1 + random() % 30;
+        for (int i = 0; i < count; ++i) {
+            engine.processes().append(i + 1, random() % 200, 1 + random() % 40, random() % 5);
+        }
+        engine.setPolicy(static_cast<SchedulingPolicy>(random() % SchedulingPolicyCount), 1 + random() % 4);
+        engine.setCoreCount(1 + random() % 3);
+        engine.setWorkStealing(random() % 2 == 0);
+        engine.setCheckpointInterval(1 + random() % 30);
+        engine.reset();
+        for (int step = 0; step < 12; ++step) {
+            const SimTime time = random() % 400;
+            if (random() % 3 != 0) {
+                engine.seekTo(time);
+            } else {
+                engine.advanceTo(std::max(time, engine.currentTime()));
+            }
+            if (!matchesFreshRun(engine, engine.currentTime())) {
+                check(false, "random seeks, run " + std::to_string(run) + " step " + std::to_string(step));
+                break;
+            }
+        }
+    }
+}
+
+void testHistogramTopBucket()
+{
+    // The largest values land in the top bucket, whose upper bound is the largest int64
+    const std::int64_t largest = std::numeric_limits<std::int64_t>::max();
+    LatencyHistogram histogram;
+    histogram.record(largest);
+    histogram.record(largest - 1);
+    check(histogram.percentile(50) == largest && histogram.percentile(100) == largest,
+          "histogram percentiles in the top bucket");
+}
+
+void testCsvRejectsNonPositiveBursts()
+{
+    const std::string csv = "ID,ArrivalTime,BurstTime,Priority\n1,0,5,1\n2,2,0,1\n3,4,-3,4\n4,6,2,2\n";
+    ProcessStore store;
+    const CsvParseResult result = parseWorkloadCsv(csv.data(), csv.size(), store, nullptr, 1);
+    check(store.size() == 2 && store.id[0] == 1 && store.id[1] == 4, "CSV rows with bursts of 0 and -3 are skipped");
+    check(result.errorCount == 2, "CSV rows with bursts of 0 and -3 are reported");
+    check(result.errors.size() == 2 && result.errors[0].line == 3 && result.errors[1].line == 4,
+          "CSV burst errors carry their line numbers");
+}
+
+void testCsvRejectsLongNumbers()
+{
+    // Longer than 64 bits can hold; the field is rejected before it overflows
+    const std::string csv = "1,0,5,1\n2,123456789012345678901234567890,5,1\n3,123456789012345678,5,1\n";
+    ProcessStore store;
+    const CsvParseResult result = parseWorkloadCsv(csv.data(), csv.size(), store, nullptr, 1);
+    check(store.size() == 2 && store.arrivalTime[1] == 123456789012345678, "CSV fields of up to 18 digits are read");
+    check(result.errorCount == 1 && !result.errors.empty() && result.errors[0].line == 2,
+          "CSV fields longer than 18 digits are reported");
+}
+
+void testSweepBurstScale()
+{
+    SweepGrid grid;
+    check(!parseSweepGrid("burst=0", grid), "sweep spec with a burst scale of 0 is rejected");
+    check(!parseSweepGrid("burst=1,-0.5", grid), "sweep spec with a negative burst scale is rejected");
+    check(!parseSweepGrid("cores=100000000", grid), "sweep spec with too many cores is rejected");
+    check(parseSweepGrid("cores=1,256", grid), "sweep spec with the most cores allowed is accepted");
+
+    // Scaled down this far, every burst would round to 0
+    ProcessStore workload;
+    for (int i = 0; i < 20; ++i) {
+        workload.append(i + 1, i, 1 + i % 5, 1);
+    }
+    SweepPoint point;
+    point.burstScale = 0.01;
+    const SweepResult result = runSweepPoint(workload, point);
+    check(result.completed == workload.size(), "sweep with a tiny burst scale completes every process");
+    ProcessStore oneTick = workload;
+    std::fill(oneTick.burstTime.begin(), oneTick.burstTime.end(), 1);
+    const SweepResult expected = runSweepPoint(oneTick, SweepPoint());
+    check(result.makespan == expected.makespan && result.averageWaitingTime == expected.averageWaitingTime,
+          "sweep with a tiny burst scale runs every process for one tick");
+}
+
+} // namespace
+
+int main()
+{
+    testMatchesPerTickReference();
+    testSeekBackPastRunningSegment();
+    testRandomSeeks();
+    testHistogramTopBucket();
+    testCsvRejectsNonPositiveBursts();
+    testCsvRejectsLongNumbers();
+    testSweepBurstScale();
+
+    if (failures > 0) {
+        std::fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
@@ -0,0 +1,37 @@
+#ifndef STRINGUTIL_H
+#define STRINGUTIL_H
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Small text helpers shared by the engine library's parsers and writers
+
+inline void setError(std::string *errorMessage, const std::string &message)
+{
+    if (errorMessage) {
+        *errorMessage = message;
+    }
+}
+
+// text without leading and trailing spaces and tabs
+inline std::string trimmed(const std::string &text)
+{
+    const std::size_t first = text.find_first_not_of(" \t");
+    const std::size_t last = text.find_last_not_of(" \t");
+    return first == std::string::npos ? std::string() : text.substr(first, last - first + 1);
+}
+
+// The trimmed parts of text between separators
+inline std::vector<std::string> split(const std::string &text, char separator)
+{
+    std::vector<std::string> parts;
+    std::string part;
+    std::istringstream stream(text);
+    while (std::getline(stream, part, separator)) {
+        parts.push_back(trimmed(part));
+    }
+    return parts;
+}
+
+#endif // STRINGUTIL_H
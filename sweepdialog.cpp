@@ -0,0 +1,298 @@
+#include "sweepdialog.h"
+
+#include <QChart>
+#include <QChartView>
+#include <QComboBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QLineSeries>
+#include <QMap>
+#include <QMessageBox>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QSplitter>
+#include <QTableWidget>
+#include <QValueAxis>
+#include <QVBoxLayout>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+namespace {
+
+const char *const DefaultGrid = "policy=fcfs,sjf,srtf,rr,priority,ppriority;rate=0.5,0.75,1,1.25,1.5";
+
+const char *const MetricNames[] = {
+    "Average Waiting Time",
+    "P99 Waiting Time",
+    "Average Turnaround Time",
+    "Average Response Time",
+    "CPU Utilization (%)",
+    "Throughput"
+};
+
+double metricValue(const SweepResult &result, int metric)
+{
+    switch (metric) {
+    case 1:
+        return static_cast<double>(result.p99WaitingTime);
+    case 2:
+        return result.averageTurnaroundTime;
+    case 3:
+        return result.averageResponseTime;
+    case 4:
+        return result.utilization;
+    case 5:
+        return result.throughput;
+    default:
+        return result.averageWaitingTime;
+    }
+}
+
+// Everything but the arrival rate, which is the chart's x axis
+QString configurationName(const SweepPoint &point)
+{
+    QString name = schedulingPolicyName(point.policy);
+    if (point.policy == SchedulingPolicy::RoundRobin) {
+        name += QString(" q=%1").arg(point.quantum);
+    }
+    if (point.cores > 1) {
+        name += QString(", %1 cores%2").arg(point.cores).arg(point.workStealing ? " + stealing" : "");
+    }
+    if (point.burstScale != 1.0) {
+        name += QString(", bursts x%1").arg(point.burstScale);
+    }
+    return name;
+}
+
+} // namespace
+
+SweepDialog::SweepDialog(std::shared_ptr<const ProcessStore> workload, QWidget *parent)
+    : QDialog(parent)
+    , workload(std::move(workload))
+{
+    setWindowTitle("Parameter Sweep");
+    resize(900, 650);
+
+    gridEdit = new QLineEdit(DefaultGrid, this);
+    gridEdit->setToolTip("policy=fcfs,sjf,srtf,rr,priority,ppriority; quantum=2,4; cores=1,8; steal=0,1; "
+                         "rate=0.5,1,1.5 (arrival rate multiplier); burst=1 (burst time multiplier)");
+    metricComboBox = new QComboBox(this);
+    for (const char *name : MetricNames) {
+        metricComboBox->addItem(name);
+    }
+    runButton = new QPushButton("Run", this);
+    exportButton = new QPushButton("Export...", this);
+    exportButton->setEnabled(false);
+    progressBar = new QProgressBar(this);
+
+    QFormLayout *form = new QFormLayout();
+    form->addRow("Grid:", gridEdit);
+    form->addRow("Metric:", metricComboBox);
+
+    QHBoxLayout *buttons = new QHBoxLayout();
+    buttons->addWidget(progressBar, 1);
+    buttons->addWidget(runButton);
+    buttons->addWidget(exportButton);
+
+    resultsTable = new QTableWidget(this);
+    resultsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    resultsTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    resultsTable->verticalHeader()->setVisible(false);
+
+    chart = new QChart();
+    chart->setAnimationOptions(QChart::NoAnimation);
+    QChartView *chartView = new QChartView(chart, this);
+    chartView->setRenderHint(QPainter::Antialiasing);
+
+    QSplitter *splitter = new QSplitter(Qt::Vertical, this);
+    splitter->addWidget(chartView);
+    splitter->addWidget(resultsTable);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addLayout(form);
+    layout->addLayout(buttons);
+    layout->addWidget(splitter, 1);
+
+    connect(runButton, &QPushButton::clicked, this, &SweepDialog::runOrCancel);
+    connect(exportButton, &QPushButton::clicked, this, &SweepDialog::exportResults);
+    connect(metricComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &SweepDialog::updateChart);
+    connect(&watcher, &QFutureWatcher<SweepResult>::progressRangeChanged, progressBar, &QProgressBar::setRange);
+    connect(&watcher, &QFutureWatcher<SweepResult>::progressValueChanged, progressBar, &QProgressBar::setValue);
+    connect(&watcher, &QFutureWatcher<SweepResult>::finished, this, &SweepDialog::sweepFinished);
+}
+
+SweepDialog::~SweepDialog()
+{
+    // Running points hold the workload; let them finish before it goes away
+    watcher.cancel();
+    watcher.waitForFinished();
+}
+
+void SweepDialog::runOrCancel()
+{
+    if (watcher.isRunning()) {
+        watcher.cancel();
+        return;
+    }
+
+    SweepGrid grid;
+    std::string errorMessage;
+    if (!parseSweepGrid(gridEdit->text().toStdString(), grid, &errorMessage)) {
+        QMessageBox::warning(this, "Parameter Sweep", QString::fromStdString(errorMessage));
+        return;
+    }
+
+    // Each point is an independent simulation, so the pool runs them side by side
+    const std::vector<SweepPoint> points = expandSweepGrid(grid);
+    std::shared_ptr<const ProcessStore> store = workload;
+    watcher.setFuture(QtConcurrent::mapped(points, [store](const SweepPoint &point) {
+        return runSweepPoint(*store, point);
+    }));
+
+    runButton->setText("Cancel");
+    exportButton->setEnabled(false);
+    gridEdit->setEnabled(false);
+}
+
+void SweepDialog::sweepFinished()
+{
+    runButton->setText("Run");
+    gridEdit->setEnabled(true);
+
+    if (watcher.isCanceled()) {
+        progressBar->reset();
+        return;
+    }
+
+    const QList<SweepResult> finished = watcher.future().results();
+    results.assign(finished.begin(), finished.end());
+    exportButton->setEnabled(!results.empty());
+    fillTable();
+    updateChart();
+}
+
+void SweepDialog::fillTable()
+{
+    const QStringList headers = {
+        "Policy", "Quantum", "Cores", "Work Stealing", "Arrival Rate", "Burst Scale", "Completed", "Makespan",
+        "Avg Waiting", "P99 Waiting", "Avg Turnaround", "Avg Response", "CPU Utilization", "Throughput", "Events"
+    };
+
+    resultsTable->setSortingEnabled(false);
+    resultsTable->clear();
+    resultsTable->setColumnCount(headers.size());
+    resultsTable->setHorizontalHeaderLabels(headers);
+    resultsTable->setRowCount(static_cast<int>(results.size()));
+
+    for (int row = 0; row < static_cast<int>(results.size()); ++row) {
+        const SweepResult &result = results[row];
+        const SweepPoint &point = result.point;
+        const QVariant values[] = {
+            schedulingPolicyName(point.policy),
+            point.policy == SchedulingPolicy::RoundRobin ? QVariant(static_cast<qlonglong>(point.quantum)) : QVariant(),
+            point.cores,
+            point.workStealing ? "Yes" : "No",
+            point.arrivalRate,
+            point.burstScale,
+            result.completed,
+            static_cast<qlonglong>(result.makespan),
+            QString::number(result.averageWaitingTime, 'f', 2).toDouble(),
+            static_cast<qlonglong>(result.p99WaitingTime),
+            QString::number(result.averageTurnaroundTime, 'f', 2).toDouble(),
+            QString::number(result.averageResponseTime, 'f', 2).toDouble(),
+            QString::number(result.utilization, 'f', 2).toDouble(),
+            QString::number(result.throughput, 'f', 4).toDouble(),
+            static_cast<qlonglong>(result.events)
+        };
+        for (int column = 0; column < headers.size(); ++column) {
+            // Numbers go in as data so the columns sort numerically
+            QTableWidgetItem *item = new QTableWidgetItem();
+            item->setData(Qt::DisplayRole, values[column]);
+            resultsTable->setItem(row, column, item);
+        }
+    }
+
+    resultsTable->setSortingEnabled(true);
+    resultsTable->resizeColumnsToContents();
+}
+
+void SweepDialog::updateChart()
+{
+    chart->removeAllSeries();
+    for (QAbstractAxis *axis : chart->axes()) {
+        chart->removeAxis(axis);
+        delete axis;
+    }
+    if (results.empty()) {
+        return;
+    }
+
+    const int metric = metricComboBox->currentIndex();
+    chart->setTitle(QString("%1 vs Arrival Rate").arg(MetricNames[metric]));
+
+    // One line per configuration, in the order the grid produced them
+    QMap<QString, QLineSeries *> seriesByName;
+    QList<QLineSeries *> seriesList;
+    double minX = results.front().point.arrivalRate;
+    double maxX = minX;
+    double minY = metricValue(results.front(), metric);
+    double maxY = minY;
+
+    for (const SweepResult &result : results) {
+        const QString name = configurationName(result.point);
+        QLineSeries *series = seriesByName.value(name);
+        if (!series) {
+            series = new QLineSeries();
+            series->setName(name);
+            series->setPointsVisible(true);
+            seriesByName.insert(name, series);
+            seriesList << series;
+        }
+        const double x = result.point.arrivalRate;
+        const double y = metricValue(result, metric);
+        series->append(x, y);
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+    }
+
+    QValueAxis *axisX = new QValueAxis();
+    axisX->setTitleText("Arrival Rate");
+    axisX->setRange(minX, maxX > minX ? maxX : minX + 1.0);
+    QValueAxis *axisY = new QValueAxis();
+    axisY->setTitleText(MetricNames[metric]);
+    axisY->setRange(std::min(minY, 0.0), maxY > minY ? maxY * 1.05 : minY + 1.0);
+    axisY->applyNiceNumbers();
+    chart->addAxis(axisX, Qt::AlignBottom);
+    chart->addAxis(axisY, Qt::AlignLeft);
+
+    for (QLineSeries *series : seriesList) {
+        chart->addSeries(series);
+        series->attachAxis(axisX);
+        series->attachAxis(axisY);
+    }
+}
+
+void SweepDialog::exportResults()
+{
+    const QString fileName = QFileDialog::getSaveFileName(this, "Export Sweep Results", "", "CSV Files (*.csv);;All Files (*)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    QFile file(fileName);
+    const std::string csv = formatSweepCsv(results);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)
+        || file.write(csv.data(), static_cast<qint64>(csv.size())) != static_cast<qint64>(csv.size())) {
+        QMessageBox::warning(this, "Export Error", "Could not write " + fileName + ".");
+        return;
+    }
+    QMessageBox::information(this, "Export Successful", "Sweep results exported successfully.");
+}
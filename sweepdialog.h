@@ -0,0 +1,52 @@
+#ifndef SWEEPDIALOG_H
+#define SWEEPDIALOG_H
+
+#include <QDialog>
+#include <QFutureWatcher>
+
+#include <memory>
+#include <vector>
+
+#include "sweeprunner.h"
+
+class QChart;
+class QComboBox;
+class QLineEdit;
+class QProgressBar;
+class QPushButton;
+class QTableWidget;
+
+// Runs a grid of independent simulations of one workload on the global
+// thread pool and shows them as a table and as a metric-versus-arrival-rate
+// chart with one line per configuration.
+class SweepDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    SweepDialog(std::shared_ptr<const ProcessStore> workload, QWidget *parent = nullptr);
+    ~SweepDialog();
+
+private slots:
+    void runOrCancel();
+    void sweepFinished();
+    void updateChart();
+    void exportResults();
+
+private:
+    std::shared_ptr<const ProcessStore> workload;
+    std::vector<SweepResult> results;
+    QFutureWatcher<SweepResult> watcher;
+
+    QLineEdit *gridEdit;
+    QComboBox *metricComboBox;
+    QPushButton *runButton;
+    QPushButton *exportButton;
+    QProgressBar *progressBar;
+    QTableWidget *resultsTable;
+    QChart *chart;
+
+    void fillTable();
+};
+
+#endif // SWEEPDIALOG_H
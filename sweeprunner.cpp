@@ -0,0 +1,207 @@
+#include "sweeprunner.h"
+#include "stringutil.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+template <typename T, typename Parse>
+bool parseList(const std::string &key, const std::string &values, std::vector<T> &list, Parse parse,
+               std::string *errorMessage)
+{
+    list.clear();
+    for (const std::string &value : split(values, ',')) {
+        T parsed;
+        if (value.empty() || !parse(value, parsed)) {
+            setError(errorMessage, "invalid " + key + " value \"" + value + "\"");
+            return false;
+        }
+        list.push_back(parsed);
+    }
+    if (list.empty()) {
+        setError(errorMessage, "no values given for " + key);
+        return false;
+    }
+    return true;
+}
+
+bool parsePolicy(const std::string &value, SchedulingPolicy &policy)
+{
+    for (int i = 0; i < SchedulingPolicyCount; ++i) {
+        if (value == schedulingPolicyKey(static_cast<SchedulingPolicy>(i))) {
+            policy = static_cast<SchedulingPolicy>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parsePositiveInteger(const std::string &value, long long &result)
+{
+    char *end = nullptr;
+    result = std::strtoll(value.c_str(), &end, 10);
+    return *end == '\0' && result > 0 && result <= INT_MAX;
+}
+
+bool parsePositiveNumber(const std::string &value, double &result)
+{
+    char *end = nullptr;
+    result = std::strtod(value.c_str(), &end);
+    return *end == '\0' && std::isfinite(result) && result > 0.0;
+}
+
+} // namespace
+
+bool parseSweepGrid(const std::string &text, SweepGrid &grid, std::string *errorMessage)
+{
+    for (const std::string &entry : split(text, ';')) {
+        if (entry.empty()) {
+            continue;
+        }
+        const std::size_t equals = entry.find('=');
+        if (equals == std::string::npos) {
+            setError(errorMessage, "expected key=values in \"" + entry + "\"");
+            return false;
+        }
+        const std::string key = trimmed(entry.substr(0, equals));
+        const std::string values = entry.substr(equals + 1);
+
+        bool parsed = false;
+        if (key == "policy") {
+            parsed = parseList(key, values, grid.policies, parsePolicy, errorMessage);
+        } else if (key == "quantum") {
+            parsed = parseList(key, values, grid.quanta, [](const std::string &value, SimTime &quantum) {
+                long long number;
+                if (!parsePositiveInteger(value, number)) {
+                    return false;
+                }
+                quantum = number;
+                return true;
+            }, errorMessage);
+        } else if (key == "cores") {
+            parsed = parseList(key, values, grid.coreCounts, [](const std::string &value, int &cores) {
+                long long number;
+                if (!parsePositiveInteger(value, number) || number > MaxCoreCount) {
+                    return false;
+                }
+                cores = static_cast<int>(number);
+                return true;
+            }, errorMessage);
+        } else if (key == "steal") {
+            parsed = parseList(key, values, grid.workStealing, [](const std::string &value, bool &enabled) {
+                enabled = value == "1";
+                return value == "0" || value == "1";
+            }, errorMessage);
+        } else if (key == "rate") {
+            parsed = parseList(key, values, grid.arrivalRates, parsePositiveNumber, errorMessage);
+        } else if (key == "burst") {
+            parsed = parseList(key, values, grid.burstScales, parsePositiveNumber, errorMessage);
+        } else {
+            setError(errorMessage, "unknown sweep parameter \"" + key + "\"");
+        }
+        if (!parsed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<SweepPoint> expandSweepGrid(const SweepGrid &grid)
+{
+    std::vector<SweepPoint> points;
+    for (SchedulingPolicy policy : grid.policies) {
+        const std::vector<SimTime> quanta = policy == SchedulingPolicy::RoundRobin
+            ? grid.quanta
+            : std::vector<SimTime>{grid.quanta.front()};
+        for (SimTime quantum : quanta) {
+            for (int cores : grid.coreCounts) {
+                std::vector<bool> stealing = grid.workStealing;
+                if (cores == 1) {
+                    stealing.assign(1, false);
+                }
+                for (bool workStealing : stealing) {
+                    for (double arrivalRate : grid.arrivalRates) {
+                        for (double burstScale : grid.burstScales) {
+                            points.push_back({policy, quantum, cores, workStealing, arrivalRate, burstScale});
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return points;
+}
+
+SweepResult runSweepPoint(const ProcessStore &workload, const SweepPoint &point)
+{
+    SchedulerEngine engine;
+    engine.setPolicy(point.policy, point.quantum);
+    engine.setCoreCount(point.cores);
+    engine.setWorkStealing(point.workStealing);
+    engine.setRecordSegments(false);
+
+    ProcessStore &store = engine.processes();
+    store = workload;
+    if (point.arrivalRate != 1.0) {
+        for (SimTime &arrival : store.arrivalTime) {
+            arrival = std::llround(arrival / point.arrivalRate);
+        }
+    }
+    if (point.burstScale != 1.0) {
+        // A small scale would round short bursts down to nothing, and every process needs a tick
+        const double scale = point.burstScale > 0.0 ? point.burstScale : 1.0;
+        for (int &burst : store.burstTime) {
+            burst = static_cast<int>(std::min(std::max(std::round(burst * scale), 1.0), static_cast<double>(INT_MAX)));
+        }
+    }
+
+    engine.reset();
+    engine.run();
+
+    SweepResult result;
+    result.point = point;
+    result.processes = store.size();
+    result.completed = engine.completedCount();
+    result.makespan = engine.currentTime();
+    result.events = engine.eventCount();
+    if (result.completed > 0) {
+        result.averageWaitingTime = static_cast<double>(engine.totalWaitingTime()) / result.completed;
+        result.averageTurnaroundTime = static_cast<double>(engine.totalTurnaroundTime()) / result.completed;
+        result.averageResponseTime = static_cast<double>(engine.totalResponseTime()) / result.completed;
+        result.p99WaitingTime = engine.waitingHistogram().percentile(99);
+    }
+    if (result.makespan > 0) {
+        result.utilization = engine.busyTime() * 100.0 / (static_cast<double>(result.makespan) * point.cores);
+        result.throughput = static_cast<double>(result.completed) / result.makespan;
+    }
+    return result;
+}
+
+std::string formatSweepCsv(const std::vector<SweepResult> &results)
+{
+    std::string csv = "Policy,Quantum,Cores,Work Stealing,Arrival Rate,Burst Scale,Processes,Completed,"
+                      "Makespan,Average Waiting Time,P99 Waiting Time,Average Turnaround Time,"
+                      "Average Response Time,CPU Utilization,Throughput,Events\n";
+    char row[512];
+    for (const SweepResult &result : results) {
+        const SweepPoint &point = result.point;
+        // The quantum only means something for Round Robin
+        char quantum[24] = "";
+        if (point.policy == SchedulingPolicy::RoundRobin) {
+            std::snprintf(quantum, sizeof(quantum), "%lld", static_cast<long long>(point.quantum));
+        }
+        std::snprintf(row, sizeof(row), "%s,%s,%d,%d,%g,%g,%d,%d,%lld,%.2f,%lld,%.2f,%.2f,%.2f,%.4f,%lld\n",
+                      schedulingPolicyKey(point.policy), quantum, point.cores,
+                      point.workStealing ? 1 : 0, point.arrivalRate, point.burstScale, result.processes,
+                      result.completed, static_cast<long long>(result.makespan), result.averageWaitingTime,
+                      static_cast<long long>(result.p99WaitingTime), result.averageTurnaroundTime,
+                      result.averageResponseTime, result.utilization, result.throughput,
+                      static_cast<long long>(result.events));
+        csv += row;
+    }
+    return csv;
+}
@@ -0,0 +1,66 @@
+#ifndef SWEEPRUNNER_H
+#define SWEEPRUNNER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "schedulerengine.h"
+
+// One simulation of a parameter sweep. The workload is transformed before
+// the run: arrival times are divided by arrivalRate (2 doubles the load) and
+// burst times are multiplied by burstScale (which must be positive) and
+// rounded, to no less than one tick.
+struct SweepPoint
+{
+    SchedulingPolicy policy = SchedulingPolicy::Fcfs;
+    SimTime quantum = 4;
+    int cores = 1;
+    bool workStealing = false;
+    double arrivalRate = 1.0;
+    double burstScale = 1.0;
+};
+
+struct SweepResult
+{
+    SweepPoint point;
+    int processes = 0;
+    int completed = 0;
+    SimTime makespan = 0;
+    std::int64_t events = 0;
+    double averageWaitingTime = 0.0;
+    double averageTurnaroundTime = 0.0;
+    double averageResponseTime = 0.0;
+    SimTime p99WaitingTime = 0;
+    double utilization = 0.0;
+    double throughput = 0.0;
+};
+
+// Values to combine. Every combination becomes one point, except that the
+// quantum only varies for Round Robin and work stealing only with several cores.
+struct SweepGrid
+{
+    std::vector<SchedulingPolicy> policies{SchedulingPolicy::Fcfs};
+    std::vector<SimTime> quanta{4};
+    std::vector<int> coreCounts{1};
+    std::vector<bool> workStealing{false};
+    std::vector<double> arrivalRates{1.0};
+    std::vector<double> burstScales{1.0};
+};
+
+// Parses "policy=fcfs,rr;quantum=2,4;cores=1,8;steal=0,1;rate=0.5,1,1.5;burst=1".
+// Keys that are left out keep their defaults; core counts go up to
+// MaxCoreCount. Returns false with a message in errorMessage if the text is
+// malformed.
+bool parseSweepGrid(const std::string &text, SweepGrid &grid, std::string *errorMessage = nullptr);
+
+std::vector<SweepPoint> expandSweepGrid(const SweepGrid &grid);
+
+// Simulates workload transformed for point to completion. Independent of
+// every other call, so points can run concurrently on a thread pool.
+SweepResult runSweepPoint(const ProcessStore &workload, const SweepPoint &point);
+
+// One CSV row per result under a header line
+std::string formatSweepCsv(const std::vector<SweepResult> &results);
+
+#endif // SWEEPRUNNER_H
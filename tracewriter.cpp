@@ -0,0 +1,226 @@
+#include "tracewriter.h"
+#include "stringutil.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+const std::size_t BufferCapacity = 1 << 20;
+// Longer than any single event or number, so a flush never splits one
+const std::size_t MaxEventLength = 256;
+
+} // namespace
+
+TraceWriter::TraceWriter()
+    : file(nullptr)
+    , used(0)
+    , failed(false)
+    , events(0)
+    , pendingTime(-1)
+    , pendingCount(0)
+    , writtenCount(0)
+{
+}
+
+TraceWriter::~TraceWriter()
+{
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+bool TraceWriter::open(const std::string &fileName, int coreCount, std::string *errorMessage)
+{
+    if (file) {
+        std::fclose(file);
+    }
+    file = std::fopen(fileName.c_str(), "wb");
+    if (!file) {
+        setError(errorMessage, "Could not open file for writing.");
+        return false;
+    }
+    buffer.resize(BufferCapacity);
+    used = 0;
+    failed = false;
+    events = 0;
+    // The engine's first tick is 1, so cores are idle from there
+    idleSince.assign(std::max(coreCount, 1), 1);
+    pendingTime = -1;
+    pendingCount = 0;
+    writtenCount = 0;
+
+    append("{\"traceEvents\":[\n"
+           "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Scheduler\"}}");
+    for (int core = 0; core < static_cast<int>(idleSince.size()); ++core) {
+        reserve(MaxEventLength);
+        append(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+        appendNumber(core);
+        append(",\"args\":{\"name\":\"CPU ");
+        appendNumber(core);
+        append("\"}}");
+    }
+    return true;
+}
+
+bool TraceWriter::close(SimTime lastTick, std::string *errorMessage)
+{
+    if (!file) {
+        return true;
+    }
+    if (pendingTime != -1 && pendingCount != writtenCount) {
+        writeCounter(pendingTime, pendingCount);
+    }
+    for (int core = 0; core < static_cast<int>(idleSince.size()); ++core) {
+        writeIdle(core, idleSince[core], lastTick + 1);
+    }
+    append("\n]}\n");
+    flush();
+
+    const bool closed = std::fclose(file) == 0 && !failed;
+    file = nullptr;
+    buffer.clear();
+    buffer.shrink_to_fit();
+    if (!closed) {
+        setError(errorMessage, "Could not write the trace file.");
+    }
+    return closed;
+}
+
+void TraceWriter::segment(int core, int processId, SimTime start, SimTime end, bool completed)
+{
+    if (end < start) {
+        return;
+    }
+    writeIdle(core, idleSince[core], start);
+    idleSince[core] = end + 1;
+
+    beginEvent();
+    append("{\"name\":\"P");
+    appendNumber(processId);
+    append(completed ? "\",\"cat\":\"completed\",\"ph\":\"X\",\"ts\":" : "\",\"cat\":\"preempted\",\"ph\":\"X\",\"ts\":");
+    appendNumber(start);
+    append(",\"dur\":");
+    appendNumber(end + 1 - start);
+    append(",\"pid\":1,\"tid\":");
+    appendNumber(core);
+    append(",\"args\":{\"id\":");
+    appendNumber(processId);
+    append("}}");
+}
+
+void TraceWriter::readyCount(SimTime time, int count)
+{
+    // Only the last count of a tick is written, and only if it changed
+    if (time != pendingTime) {
+        if (pendingTime != -1 && pendingCount != writtenCount) {
+            writeCounter(pendingTime, pendingCount);
+        }
+        pendingTime = time;
+    }
+    pendingCount = count;
+}
+
+void TraceWriter::writeCounter(SimTime time, int count)
+{
+    beginEvent();
+    append("{\"name\":\"Ready queue\",\"ph\":\"C\",\"ts\":");
+    appendNumber(time);
+    append(",\"pid\":1,\"args\":{\"processes\":");
+    appendNumber(count);
+    append("}}");
+    writtenCount = count;
+}
+
+void TraceWriter::writeIdle(int core, SimTime start, SimTime end)
+{
+    if (end <= start) {
+        return;
+    }
+    beginEvent();
+    append("{\"name\":\"Idle\",\"cat\":\"idle\",\"ph\":\"X\",\"ts\":");
+    appendNumber(start);
+    append(",\"dur\":");
+    appendNumber(end - start);
+    append(",\"pid\":1,\"tid\":");
+    appendNumber(core);
+    append("}");
+}
+
+void TraceWriter::beginEvent()
+{
+    reserve(MaxEventLength);
+    append(",\n");
+    ++events;
+}
+
+void TraceWriter::append(const char *text)
+{
+    const std::size_t length = std::strlen(text);
+    reserve(length);
+    std::memcpy(buffer.data() + used, text, length);
+    used += length;
+}
+
+void TraceWriter::appendNumber(std::int64_t value)
+{
+    used = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value).ptr - buffer.data();
+}
+
+void TraceWriter::reserve(std::size_t length)
+{
+    if (used + length > buffer.size()) {
+        flush();
+    }
+}
+
+void TraceWriter::flush()
+{
+    if (used > 0 && !failed) {
+        failed = std::fwrite(buffer.data(), 1, used, file) != used;
+    }
+    used = 0;
+}
+
+bool writeScheduleTrace(const SchedulerEngine &source, const std::string &fileName,
+                        std::string *errorMessage, TraceProgress *progress)
+{
+    SchedulerEngine engine;
+    engine.processes() = source.processes();
+    engine.copySettings(source);
+    // The export never seeks, so checkpoints would only cost memory
+    engine.setCheckpointInterval(0);
+    engine.setRecordSegments(false);
+    TraceWriter trace;
+    engine.setTrace(&trace);
+    engine.reset();
+    if (!trace.open(fileName, engine.coreCount(), errorMessage)) {
+        return false;
+    }
+
+    // Slices of roughly 10 ms keep cancelling responsive whatever the tick density
+    using Clock = std::chrono::steady_clock;
+    SimTime stride = 1;
+    while (!engine.isFinished()) {
+        if (progress && progress->cancelRequested) {
+            trace.close(engine.currentTime());
+            std::remove(fileName.c_str());
+            setError(errorMessage, "Trace export cancelled.");
+            return false;
+        }
+        const Clock::time_point begin = Clock::now();
+        engine.advanceTo(engine.currentTime() + stride);
+        const Clock::duration elapsed = Clock::now() - begin;
+        if (elapsed < std::chrono::milliseconds(5)) {
+            stride = stride < (SimTime(1) << 40) ? stride * 2 : stride;
+        } else if (elapsed > std::chrono::milliseconds(20)) {
+            stride = std::max<SimTime>(stride / 2, 1);
+        }
+        if (progress) {
+            progress->completed = engine.completedCount();
+        }
+    }
+    return trace.close(engine.currentTime(), errorMessage);
+}
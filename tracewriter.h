@@ -0,0 +1,74 @@
+#ifndef TRACEWRITER_H
+#define TRACEWRITER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "schedulerengine.h"
+
+// Streams the schedule of a SchedulerEngine as Chrome trace-event JSON, which
+// chrome://tracing and the Perfetto UI load. Every core is a thread of one
+// "Scheduler" process; each execution segment is a complete ("X") event named
+// after the process, with gaps between them written as "Idle" events, and the
+// ready queue length is a counter track. One tick is shown as one microsecond.
+//
+// Events are written as the engine produces them through a fixed-size buffer,
+// so memory use does not grow with the length of the run.
+class TraceWriter
+{
+public:
+    TraceWriter();
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter &) = delete;
+    TraceWriter &operator=(const TraceWriter &) = delete;
+
+    // Starts a trace of coreCount cores
+    bool open(const std::string &fileName, int coreCount, std::string *errorMessage = nullptr);
+    // Writes the idle spans up to and including lastTick and ends the JSON
+    bool close(SimTime lastTick, std::string *errorMessage = nullptr);
+    bool isOpen() const { return file != nullptr; }
+    std::int64_t eventCount() const { return events; }
+
+    // Called by the engine. Segments of one core come in order and cover
+    // ticks [start, end]; ready counts come with non-decreasing times.
+    void segment(int core, int processId, SimTime start, SimTime end, bool completed);
+    void readyCount(SimTime time, int count);
+
+private:
+    std::FILE *file;
+    std::vector<char> buffer;
+    std::size_t used;
+    bool failed;
+    std::int64_t events;
+    std::vector<SimTime> idleSince;
+    SimTime pendingTime;
+    int pendingCount;
+    int writtenCount;
+
+    void append(const char *text);
+    void appendNumber(std::int64_t value);
+    void beginEvent();
+    void writeCounter(SimTime time, int count);
+    void writeIdle(int core, SimTime start, SimTime end);
+    void reserve(std::size_t length);
+    void flush();
+};
+
+struct TraceProgress
+{
+    std::atomic<int> completed{0};
+    std::atomic<bool> cancelRequested{false};
+};
+
+// Simulates a copy of source's processes and settings from time 0 to the last
+// completion and writes its trace to fileName. Safe to call from a worker
+// thread as long as source is not modified meanwhile; a cancelled trace
+// removes the partial file.
+bool writeScheduleTrace(const SchedulerEngine &source, const std::string &fileName,
+                        std::string *errorMessage = nullptr, TraceProgress *progress = nullptr);
+
+#endif // TRACEWRITER_H
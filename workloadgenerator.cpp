@@ -0,0 +1,307 @@
+#include "workloadgenerator.h"
+#include "stringutil.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+// Rows per random stream; fixed so the output does not depend on the thread count
+const int ChunkSize = 1 << 16;
+
+const double MaxBurst = 1e9;
+
+// SplitMix64: tiny state, good enough statistics for workloads and cheap to seed per chunk
+struct Random
+{
+    std::uint64_t state;
+
+    std::uint64_t next()
+    {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform on (0, 1), never 0 so it can go straight into log()
+    double uniform() { return (static_cast<double>(next() >> 11) + 0.5) * (1.0 / 9007199254740992.0); }
+
+    double exponential(double mean) { return -std::log(uniform()) * mean; }
+};
+
+Random chunkStream(std::uint64_t seed, int chunk, std::uint64_t stream)
+{
+    Random random{seed ^ (stream * 0xD1B54A32D192ED03ull)};
+    random.state += static_cast<std::uint64_t>(chunk) * 0xA0761D6478BD642Full;
+    random.next();
+    return random;
+}
+
+// Draws the gap before each process of one chunk
+class ArrivalSampler
+{
+public:
+    ArrivalSampler(const WorkloadSpec &spec, int chunk)
+        : random(chunkStream(spec.seed, chunk, 1))
+        , bursty(spec.arrivals == ArrivalPattern::Bursty)
+        , meanGap(1.0 / spec.arrivalRate)
+    {
+        // Inside a cluster the rate is burstIntensity times higher; the gap
+        // that starts a cluster makes up the difference
+        const double size = std::max(spec.clusterSize, 1.0);
+        clusterStart = 1.0 / size;
+        innerGap = meanGap / spec.burstIntensity;
+        outerGap = size * meanGap - (size - 1.0) * innerGap;
+    }
+
+    double next()
+    {
+        if (!bursty) {
+            return random.exponential(meanGap);
+        }
+        return random.uniform() < clusterStart ? random.exponential(outerGap) : random.exponential(innerGap);
+    }
+
+private:
+    Random random;
+    bool bursty;
+    double meanGap;
+    double clusterStart = 1.0;
+    double innerGap = 0.0;
+    double outerGap = 0.0;
+};
+
+int sampleBurst(const WorkloadSpec &spec, Random &random)
+{
+    double burst;
+    switch (spec.bursts) {
+    case BurstDistribution::Pareto: {
+        const double scale = spec.meanBurst * (spec.paretoShape - 1.0) / spec.paretoShape;
+        burst = scale * std::exp(-std::log(random.uniform()) / spec.paretoShape);
+        break;
+    }
+    case BurstDistribution::Bimodal:
+        burst = random.uniform() < spec.shortFraction
+            ? random.exponential(spec.shortBurst)
+            : random.exponential(spec.longBurst);
+        break;
+    default:
+        burst = random.exponential(spec.meanBurst);
+        break;
+    }
+    return burst < 1.5 ? 1 : static_cast<int>(std::min(burst + 0.5, MaxBurst));
+}
+
+// Runs work(chunk) for every chunk on all hardware threads
+template <typename Work>
+void forEachChunk(int chunkCount, Work work)
+{
+    const int threadCount = std::min<int>(std::max(1u, std::thread::hardware_concurrency()), chunkCount);
+    if (threadCount <= 1) {
+        for (int chunk = 0; chunk < chunkCount; ++chunk) {
+            work(chunk);
+        }
+        return;
+    }
+
+    std::atomic<int> nextChunk{0};
+    auto drain = [&]() {
+        for (int chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++) {
+            work(chunk);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < threadCount; ++i) {
+        threads.emplace_back(drain);
+    }
+    drain();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+bool parseNumber(const std::string &value, double &result)
+{
+    char *end = nullptr;
+    result = std::strtod(value.c_str(), &end);
+    return !value.empty() && *end == '\0' && std::isfinite(result);
+}
+
+bool parseInteger(const std::string &value, long long &result)
+{
+    char *end = nullptr;
+    result = std::strtoll(value.c_str(), &end, 10);
+    return !value.empty() && *end == '\0';
+}
+
+} // namespace
+
+bool parseWorkloadSpec(const std::string &text, WorkloadSpec &spec, std::string *errorMessage)
+{
+    for (const std::string &entry : split(text, ';')) {
+        if (entry.empty()) {
+            continue;
+        }
+        const std::size_t equals = entry.find('=');
+        if (equals == std::string::npos) {
+            setError(errorMessage, "expected key=value in \"" + entry + "\"");
+            return false;
+        }
+        const std::string key = trimmed(entry.substr(0, equals));
+        const std::string value = trimmed(entry.substr(equals + 1));
+
+        double number = 0.0;
+        long long integer = 0;
+        bool parsed = true;
+        if (key == "count") {
+            parsed = parseInteger(value, integer) && integer >= 0 && integer <= INT_MAX;
+            spec.count = static_cast<int>(integer);
+        } else if (key == "firstid") {
+            parsed = parseInteger(value, integer) && integer >= INT_MIN && integer <= INT_MAX;
+            spec.firstId = static_cast<int>(integer);
+        } else if (key == "seed") {
+            char *end = nullptr;
+            spec.seed = std::strtoull(value.c_str(), &end, 10);
+            parsed = !value.empty() && *end == '\0';
+        } else if (key == "arrivals") {
+            parsed = value == "poisson" || value == "bursty";
+            spec.arrivals = value == "bursty" ? ArrivalPattern::Bursty : ArrivalPattern::Poisson;
+        } else if (key == "bursts") {
+            parsed = value == "exponential" || value == "pareto" || value == "bimodal";
+            spec.bursts = value == "pareto" ? BurstDistribution::Pareto
+                : value == "bimodal" ? BurstDistribution::Bimodal
+                : BurstDistribution::Exponential;
+        } else if (key == "priorities") {
+            spec.priorityWeights.clear();
+            for (const std::string &weight : split(value, ',')) {
+                parsed = parsed && parseNumber(weight, number);
+                spec.priorityWeights.push_back(number);
+            }
+        } else {
+            double *field = key == "rate" ? &spec.arrivalRate
+                : key == "cluster" ? &spec.clusterSize
+                : key == "intensity" ? &spec.burstIntensity
+                : key == "mean" ? &spec.meanBurst
+                : key == "shape" ? &spec.paretoShape
+                : key == "short" ? &spec.shortBurst
+                : key == "long" ? &spec.longBurst
+                : key == "shortfraction" ? &spec.shortFraction
+                : nullptr;
+            if (!field) {
+                setError(errorMessage, "unknown workload parameter \"" + key + "\"");
+                return false;
+            }
+            parsed = parseNumber(value, *field);
+        }
+        if (!parsed) {
+            setError(errorMessage, "invalid " + key + " value \"" + value + "\"");
+            return false;
+        }
+    }
+    return validateWorkloadSpec(spec, errorMessage);
+}
+
+bool validateWorkloadSpec(const WorkloadSpec &spec, std::string *errorMessage)
+{
+    if (spec.count < 0 || static_cast<long long>(spec.firstId) + spec.count - 1 > INT_MAX) {
+        setError(errorMessage, "the process count does not fit the id range");
+        return false;
+    }
+    if (!(spec.arrivalRate > 0.0) || !(spec.clusterSize >= 1.0) || !(spec.burstIntensity >= 1.0)) {
+        setError(errorMessage, "the arrival rate must be positive, the cluster size and intensity at least 1");
+        return false;
+    }
+    if (!(spec.meanBurst > 0.0) || !(spec.paretoShape > 1.0) || !(spec.shortBurst > 0.0)
+        || !(spec.longBurst > 0.0) || !(spec.shortFraction >= 0.0 && spec.shortFraction <= 1.0)) {
+        setError(errorMessage, "burst means must be positive, the Pareto shape above 1 and the short fraction within [0, 1]");
+        return false;
+    }
+    double totalWeight = 0.0;
+    for (double weight : spec.priorityWeights) {
+        if (!(weight >= 0.0)) {
+            setError(errorMessage, "priority weights cannot be negative");
+            return false;
+        }
+        totalWeight += weight;
+    }
+    if (!(totalWeight > 0.0)) {
+        setError(errorMessage, "at least one priority needs a positive weight");
+        return false;
+    }
+    return true;
+}
+
+void generateWorkload(const WorkloadSpec &spec, ProcessStore &store)
+{
+    const int count = std::max(spec.count, 0);
+    const int chunkCount = (count + ChunkSize - 1) / ChunkSize;
+
+    // Priority k + 1 is drawn when the uniform sample falls between
+    // cumulative[k - 1] and cumulative[k]; the last bound is implicitly 1
+    std::vector<double> cumulative;
+    double totalWeight = 0.0;
+    for (double weight : spec.priorityWeights) {
+        totalWeight += weight;
+        cumulative.push_back(totalWeight);
+    }
+    for (double &bound : cumulative) {
+        bound /= totalWeight;
+    }
+    if (!cumulative.empty()) {
+        cumulative.pop_back();
+    }
+
+    store.clear();
+    store.id.resize(count);
+    store.arrivalTime.resize(count);
+    store.burstTime.resize(count);
+    store.priority.resize(count);
+    store.startTime.assign(count, -1);
+    store.completionTime.assign(count, -1);
+    store.status.assign(count, ProcessStatus::Waiting);
+
+    // Arrival times are a running sum over all chunks. Each chunk first
+    // parks the offsets from its own start in the arrival column; once the
+    // spans of all chunks are known they become absolute times.
+    std::vector<double> chunkStart(chunkCount + 1, 0.0);
+    forEachChunk(chunkCount, [&](int chunk) {
+        ArrivalSampler gaps(spec, chunk);
+        Random random = chunkStream(spec.seed, chunk, 2);
+        const int begin = chunk * ChunkSize;
+        const int end = std::min(begin + ChunkSize, count);
+        double offset = 0.0;
+        for (int i = begin; i < end; ++i) {
+            offset += gaps.next();
+            std::memcpy(&store.arrivalTime[i], &offset, sizeof(offset));
+            store.id[i] = spec.firstId + i;
+            store.burstTime[i] = sampleBurst(spec, random);
+            // Branch-free, the levels are unpredictable by design
+            const double u = random.uniform();
+            int level = 1;
+            for (double bound : cumulative) {
+                level += u >= bound;
+            }
+            store.priority[i] = level;
+        }
+        chunkStart[chunk + 1] = offset;
+    });
+    for (int chunk = 0; chunk < chunkCount; ++chunk) {
+        chunkStart[chunk + 1] += chunkStart[chunk];
+    }
+
+    forEachChunk(chunkCount, [&](int chunk) {
+        const int begin = chunk * ChunkSize;
+        const int end = std::min(begin + ChunkSize, count);
+        for (int i = begin; i < end; ++i) {
+            double offset;
+            std::memcpy(&offset, &store.arrivalTime[i], sizeof(offset));
+            store.arrivalTime[i] = static_cast<SimTime>(chunkStart[chunk] + offset);
+        }
+    });
+}
@@ -0,0 +1,67 @@
+#ifndef WORKLOADGENERATOR_H
+#define WORKLOADGENERATOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "schedulerengine.h"
+
+enum class ArrivalPattern : std::uint8_t {
+    Poisson,
+    Bursty
+};
+
+enum class BurstDistribution : std::uint8_t {
+    Exponential,
+    Pareto,
+    Bimodal
+};
+
+// Parameters of a synthetic workload. Times are in ticks.
+//
+// Poisson arrivals are spaced by exponential gaps with mean 1 / arrivalRate.
+// Bursty arrivals come in clusters of clusterSize processes on average, packed
+// burstIntensity times as densely as the mean rate, with longer quiet gaps in
+// between so the long-run rate is still arrivalRate.
+//
+// Burst times are exponential or Pareto with mean meanBurst (paretoShape is
+// the tail index and must be above 1), or a mix of two exponentials: short
+// jobs with mean shortBurst with probability shortFraction and long ones with
+// mean longBurst. They are rounded and clamped to at least 1.
+//
+// Priorities 1, 2, ... are drawn with the relative weights priorityWeights.
+struct WorkloadSpec
+{
+    int count = 1000;
+    std::uint64_t seed = 1;
+    int firstId = 1;
+    ArrivalPattern arrivals = ArrivalPattern::Poisson;
+    double arrivalRate = 0.2;
+    double clusterSize = 20.0;
+    double burstIntensity = 10.0;
+    BurstDistribution bursts = BurstDistribution::Exponential;
+    double meanBurst = 4.0;
+    double paretoShape = 1.5;
+    double shortBurst = 2.0;
+    double longBurst = 40.0;
+    double shortFraction = 0.9;
+    std::vector<double> priorityWeights{1.0, 1.0, 1.0, 1.0, 1.0};
+};
+
+// Parses "count=1000000;seed=42;arrivals=bursty;rate=0.5;cluster=20;intensity=10;
+// bursts=pareto;mean=4;shape=1.5;short=2;long=40;shortfraction=0.9;priorities=1,2,1".
+// Keys that are left out keep the values already in spec. Returns false with
+// a message in errorMessage if the text is malformed.
+bool parseWorkloadSpec(const std::string &text, WorkloadSpec &spec, std::string *errorMessage = nullptr);
+
+// Checks the ranges documented on WorkloadSpec
+bool validateWorkloadSpec(const WorkloadSpec &spec, std::string *errorMessage = nullptr);
+
+// Replaces the contents of store with spec.count processes in arrival order,
+// with ids counting up from spec.firstId. The rows are generated in fixed-size
+// chunks with their own random streams on all hardware threads, so the result
+// only depends on spec, not on the number of threads.
+void generateWorkload(const WorkloadSpec &spec, ProcessStore &store);
+
+#endif // WORKLOADGENERATOR_H
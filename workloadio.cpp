@@ -0,0 +1,511 @@
+#include "workloadio.h"
+
+#include <QFile>
+#include <QStringList>
+
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cstring>
+
+namespace {
+
+enum BinaryColumnType : quint32 {
+    Int32Column = 1,
+    Int64Column = 2,
+    UInt8Column = 3
+};
+
+struct BinaryHeader
+{
+    char magic[8];
+    quint32 version;
+    quint32 columnCount;
+    quint64 rowCount;
+    qint64 currentTime;
+};
+
+struct BinaryColumnEntry
+{
+    char name[16];
+    quint32 type;
+    quint32 elementSize;
+    quint64 offset;
+};
+
+static_assert(sizeof(BinaryHeader) == 32, "binary header layout");
+static_assert(sizeof(BinaryColumnEntry) == 32, "binary column entry layout");
+
+struct BinaryColumnSource
+{
+    const char *name;
+    BinaryColumnType type;
+    const void *data;
+};
+
+quint32 elementSizeOf(BinaryColumnType type)
+{
+    switch (type) {
+    case Int64Column:
+        return 8;
+    case UInt8Column:
+        return 1;
+    default:
+        return 4;
+    }
+}
+
+quint64 alignTo64(quint64 offset)
+{
+    return (offset + 63) & ~quint64(63);
+}
+
+void setError(QString *errorMessage, const QString &message)
+{
+    if (errorMessage) {
+        *errorMessage = message;
+    }
+}
+
+// Finds a column by name and checks that it lies inside the mapped file
+const uchar *findColumn(const uchar *data, quint64 fileSize, const BinaryHeader &header,
+                        const char *name, BinaryColumnType type)
+{
+    const BinaryColumnEntry *entries = reinterpret_cast<const BinaryColumnEntry *>(data + sizeof(BinaryHeader));
+    for (quint32 i = 0; i < header.columnCount; ++i) {
+        const BinaryColumnEntry &entry = entries[i];
+        if (std::strncmp(entry.name, name, sizeof(entry.name)) != 0) {
+            continue;
+        }
+        if (entry.type != type || entry.elementSize != elementSizeOf(type)) {
+            return nullptr;
+        }
+        const quint64 bytes = header.rowCount * entry.elementSize;
+        if (entry.offset > fileSize || bytes > fileSize - entry.offset) {
+            return nullptr;
+        }
+        return data + entry.offset;
+    }
+    return nullptr;
+}
+
+template <typename T>
+void copyColumn(std::vector<T> &column, const uchar *source, quint64 rowCount)
+{
+    column.resize(rowCount);
+    if (rowCount > 0) {
+        std::memcpy(column.data(), source, rowCount * sizeof(T));
+    }
+}
+
+// Accumulates output in a large buffer and hands it to the file in big writes
+class OutputBuffer
+{
+public:
+    explicit OutputBuffer(QFile *file)
+        : file(file)
+        , buffer(Capacity)
+        , used(0)
+        , failed(false)
+    {
+    }
+
+    void append(char c)
+    {
+        if (used == Capacity) {
+            flush();
+        }
+        buffer[used++] = c;
+    }
+
+    void append(const char *text)
+    {
+        const std::size_t length = std::strlen(text);
+        if (used + length > Capacity) {
+            flush();
+        }
+        std::memcpy(buffer.data() + used, text, length);
+        used += length;
+    }
+
+    void appendNumber(std::int64_t value)
+    {
+        if (used + MaxNumberLength > Capacity) {
+            flush();
+        }
+        used = std::to_chars(buffer.data() + used, buffer.data() + Capacity, value).ptr - buffer.data();
+    }
+
+    void appendFixed(double value)
+    {
+        append(QByteArray::number(value, 'f', 2).constData());
+    }
+
+    bool flush()
+    {
+        if (used > 0 && !failed) {
+            failed = file->write(buffer.data(), static_cast<qint64>(used)) != static_cast<qint64>(used);
+        }
+        used = 0;
+        return !failed;
+    }
+
+private:
+    static const std::size_t Capacity = 1 << 20;
+    static const std::size_t MaxNumberLength = 20;
+
+    QFile *file;
+    std::vector<char> buffer;
+    std::size_t used;
+    bool failed;
+};
+
+const int ProgressRowInterval = 4096;
+
+// "Waiting Time P50,3" ... "Waiting Time Max,17" summary lines
+void appendPercentiles(OutputBuffer &out, const char *metric, const LatencyHistogram &histogram)
+{
+    const LatencySummary summary = histogram.summary();
+    const char *const labels[] = { " P50,", " P90,", " P99,", " P99.9,", " Max," };
+    const std::int64_t values[] = { summary.p50, summary.p90, summary.p99, summary.p999, summary.max };
+    for (int i = 0; i < 5; ++i) {
+        out.append(metric);
+        out.append(labels[i]);
+        out.appendNumber(values[i]);
+        out.append('\n');
+    }
+}
+
+} // namespace
+
+bool loadWorkloadCsv(const QString &fileName, ProcessStore &store, QString *errorMessage,
+                     CsvParseResult *result, CsvParseProgress *progress)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (errorMessage) {
+            *errorMessage = "Could not open file for reading.";
+        }
+        return false;
+    }
+
+    CsvParseResult parseResult;
+    if (file.size() == 0) {
+        store.clear();
+    } else {
+        // Parse straight from the page cache instead of copying lines into QStrings
+        const uchar *data = file.map(0, file.size());
+        if (!data) {
+            if (errorMessage) {
+                *errorMessage = "Could not map file into memory.";
+            }
+            return false;
+        }
+        parseResult = parseWorkloadCsv(reinterpret_cast<const char *>(data), static_cast<std::size_t>(file.size()), store, progress);
+        file.unmap(const_cast<uchar *>(data));
+    }
+
+    if (parseResult.cancelled && errorMessage) {
+        *errorMessage = "Import cancelled.";
+    }
+    const bool loaded = !parseResult.cancelled;
+    if (result) {
+        *result = std::move(parseResult);
+    }
+    return loaded;
+}
+
+QString describeCsvErrors(const CsvParseResult &result, int maxLines)
+{
+    QStringList lines;
+    for (const CsvParseError &error : result.errors) {
+        if (lines.size() == maxLines) {
+            break;
+        }
+        lines << QString("Line %1: %2").arg(error.line).arg(QString::fromStdString(error.message));
+    }
+    if (result.errorCount > lines.size()) {
+        lines << QString("... and %1 more").arg(result.errorCount - lines.size());
+    }
+    return lines.join('\n');
+}
+
+bool writeResultsCsv(const QString &fileName, const ProcessStore &store, SimTime currentTime,
+                     QString *errorMessage, ExportProgress *progress)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        setError(errorMessage, "Could not open file for writing.");
+        return false;
+    }
+
+    OutputBuffer out(&file);
+
+    // Write header
+    out.append("Process ID,Arrival Time,Burst Time,Priority,Start Time,Completion Time,Turnaround Time,Waiting Time,Response Time,Status\n");
+
+    // Write data, accumulating the summary on the same pass
+    int completedProcesses = 0;
+    SimTime totalTurnaroundTime = 0;
+    SimTime totalWaitingTime = 0;
+    SimTime totalResponseTime = 0;
+    LatencyHistogram turnaroundTimes;
+    LatencyHistogram waitingTimes;
+    LatencyHistogram responseTimes;
+
+    for (int i = 0; i < store.size(); ++i) {
+        out.appendNumber(store.id[i]);
+        out.append(',');
+        out.appendNumber(store.arrivalTime[i]);
+        out.append(',');
+        out.appendNumber(store.burstTime[i]);
+        out.append(',');
+        out.appendNumber(store.priority[i]);
+        out.append(',');
+
+        if (store.startTime[i] != -1) {
+            out.appendNumber(store.startTime[i]);
+        }
+        out.append(',');
+
+        if (store.completionTime[i] != -1) {
+            const SimTime turnaroundTime = store.turnaroundTime(i);
+            const SimTime waitingTime = store.waitingTime(i);
+            const SimTime responseTime = store.responseTime(i);
+
+            out.appendNumber(store.completionTime[i]);
+            out.append(',');
+            out.appendNumber(turnaroundTime);
+            out.append(',');
+            out.appendNumber(waitingTime);
+            out.append(',');
+            out.appendNumber(responseTime);
+
+            completedProcesses++;
+            totalTurnaroundTime += turnaroundTime;
+            totalWaitingTime += waitingTime;
+            totalResponseTime += responseTime;
+            turnaroundTimes.record(turnaroundTime);
+            waitingTimes.record(waitingTime);
+            responseTimes.record(responseTime);
+        } else {
+            out.append(",,,");
+        }
+
+        out.append(',');
+        out.append(processStatusName(store.status[i]));
+        out.append('\n');
+
+        if (progress && (i & (ProgressRowInterval - 1)) == ProgressRowInterval - 1) {
+            progress->rowsWritten = i + 1;
+            if (progress->cancelRequested) {
+                file.close();
+                file.remove();
+                setError(errorMessage, "Export cancelled.");
+                return false;
+            }
+        }
+    }
+
+    // Write summary statistics
+    out.append("\nSummary Statistics\n");
+    out.append("Total Processes,");
+    out.appendNumber(store.size());
+    out.append('\n');
+
+    if (currentTime > 0 && completedProcesses > 0) {
+        out.append("Completed Processes,");
+        out.appendNumber(completedProcesses);
+        out.append('\n');
+        out.append("Average Turnaround Time,");
+        out.appendFixed(static_cast<double>(totalTurnaroundTime) / completedProcesses);
+        out.append('\n');
+        out.append("Average Waiting Time,");
+        out.appendFixed(static_cast<double>(totalWaitingTime) / completedProcesses);
+        out.append('\n');
+        out.append("Average Response Time,");
+        out.appendFixed(static_cast<double>(totalResponseTime) / completedProcesses);
+        out.append('\n');
+        out.append("Throughput,");
+        out.appendFixed(static_cast<double>(completedProcesses) / currentTime);
+        out.append(" processes/unit time\n");
+        appendPercentiles(out, "Turnaround Time", turnaroundTimes);
+        appendPercentiles(out, "Waiting Time", waitingTimes);
+        appendPercentiles(out, "Response Time", responseTimes);
+    }
+
+    if (progress) {
+        progress->rowsWritten = store.size();
+    }
+    if (!out.flush()) {
+        setError(errorMessage, "Could not write results: " + file.errorString());
+        file.close();
+        file.remove();
+        return false;
+    }
+    return true;
+}
+
+bool isBinaryWorkloadFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    char magic[sizeof(BinaryWorkloadMagic)];
+    return file.read(magic, sizeof(magic)) == sizeof(magic)
+        && std::memcmp(magic, BinaryWorkloadMagic, sizeof(magic)) == 0;
+}
+
+bool loadWorkloadBinary(const QString &fileName, ProcessStore &store, QString *errorMessage)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        setError(errorMessage, "Could not open file for reading.");
+        return false;
+    }
+
+    const quint64 fileSize = static_cast<quint64>(file.size());
+    if (fileSize < sizeof(BinaryHeader)) {
+        setError(errorMessage, "File is too small to be a binary workload.");
+        return false;
+    }
+
+    const uchar *data = file.map(0, file.size());
+    if (!data) {
+        setError(errorMessage, "Could not map file into memory.");
+        return false;
+    }
+
+    BinaryHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    QString problem;
+    if (std::memcmp(header.magic, BinaryWorkloadMagic, sizeof(header.magic)) != 0) {
+        problem = "Not a binary workload file.";
+    } else if (header.version != BinaryWorkloadVersion) {
+        problem = QString("Unsupported binary workload version %1.").arg(header.version);
+    } else if (header.columnCount > (fileSize - sizeof(BinaryHeader)) / sizeof(BinaryColumnEntry)
+               || header.rowCount > static_cast<quint64>(INT_MAX)) {
+        problem = "Binary workload header is corrupt.";
+    }
+
+    const uchar *ids = nullptr;
+    const uchar *arrivals = nullptr;
+    const uchar *bursts = nullptr;
+    const uchar *priorities = nullptr;
+    if (problem.isEmpty()) {
+        ids = findColumn(data, fileSize, header, "id", Int32Column);
+        arrivals = findColumn(data, fileSize, header, "arrival", Int64Column);
+        bursts = findColumn(data, fileSize, header, "burst", Int32Column);
+        priorities = findColumn(data, fileSize, header, "priority", Int32Column);
+        if (!ids || !arrivals || !bursts || !priorities) {
+            problem = "Binary workload is missing or has a damaged input column.";
+        }
+    }
+    for (quint64 row = 0; problem.isEmpty() && row < header.rowCount; ++row) {
+        qint32 burst;
+        std::memcpy(&burst, bursts + row * sizeof(burst), sizeof(burst));
+        if (!ProcessStore::isValidBurstTime(burst)) {
+            problem = QString("Binary workload row %1 has a burst time that is not positive.").arg(row + 1);
+        }
+    }
+
+    if (!problem.isEmpty()) {
+        file.unmap(const_cast<uchar *>(data));
+        setError(errorMessage, problem);
+        return false;
+    }
+
+    // One block copy per column; results are recomputed by the engine
+    store.clear();
+    copyColumn(store.id, ids, header.rowCount);
+    copyColumn(store.arrivalTime, arrivals, header.rowCount);
+    copyColumn(store.burstTime, bursts, header.rowCount);
+    copyColumn(store.priority, priorities, header.rowCount);
+    store.startTime.resize(header.rowCount);
+    store.completionTime.resize(header.rowCount);
+    store.status.resize(header.rowCount);
+    store.resetResults();
+
+    file.unmap(const_cast<uchar *>(data));
+    return true;
+}
+
+bool writeWorkloadBinary(const QString &fileName, const ProcessStore &store, SimTime currentTime,
+                         bool includeResults, QString *errorMessage, ExportProgress *progress)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        setError(errorMessage, "Could not open file for writing.");
+        return false;
+    }
+
+    std::vector<BinaryColumnSource> columns = {
+        { "id", Int32Column, store.id.data() },
+        { "arrival", Int64Column, store.arrivalTime.data() },
+        { "burst", Int32Column, store.burstTime.data() },
+        { "priority", Int32Column, store.priority.data() }
+    };
+    if (includeResults) {
+        columns.push_back({ "start", Int64Column, store.startTime.data() });
+        columns.push_back({ "completion", Int64Column, store.completionTime.data() });
+        columns.push_back({ "status", UInt8Column, store.status.data() });
+    }
+
+    const quint64 rowCount = static_cast<quint64>(store.size());
+
+    BinaryHeader header;
+    std::memcpy(header.magic, BinaryWorkloadMagic, sizeof(header.magic));
+    header.version = BinaryWorkloadVersion;
+    header.columnCount = static_cast<quint32>(columns.size());
+    header.rowCount = rowCount;
+    header.currentTime = includeResults ? currentTime : 0;
+
+    std::vector<BinaryColumnEntry> entries(columns.size());
+    quint64 offset = alignTo64(sizeof(BinaryHeader) + entries.size() * sizeof(BinaryColumnEntry));
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        BinaryColumnEntry &entry = entries[i];
+        std::memset(&entry, 0, sizeof(entry));
+        std::strncpy(entry.name, columns[i].name, sizeof(entry.name) - 1);
+        entry.type = columns[i].type;
+        entry.elementSize = elementSizeOf(columns[i].type);
+        entry.offset = offset;
+        offset = alignTo64(offset + rowCount * entry.elementSize);
+    }
+
+    bool ok = file.write(reinterpret_cast<const char *>(&header), sizeof(header)) == sizeof(header);
+    ok = ok && file.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(BinaryColumnEntry))
+                   == static_cast<qint64>(entries.size() * sizeof(BinaryColumnEntry));
+
+    // Columns go out in blocks of rows, so progress covers every column in turn
+    static const char padding[64] = {};
+    const quint64 blockRows = static_cast<quint64>(ProgressRowInterval) * 16;
+    for (std::size_t i = 0; ok && i < columns.size(); ++i) {
+        const qint64 gap = static_cast<qint64>(entries[i].offset) - file.pos();
+        ok = gap >= 0 && gap <= 64 && file.write(padding, gap) == gap;
+        const char *data = static_cast<const char *>(columns[i].data);
+        for (quint64 row = 0; ok && row < rowCount; row += blockRows) {
+            const quint64 rows = std::min(blockRows, rowCount - row);
+            const qint64 bytes = static_cast<qint64>(rows * entries[i].elementSize);
+            ok = file.write(data + row * entries[i].elementSize, bytes) == bytes;
+            if (progress) {
+                progress->rowsWritten = static_cast<int>((i * rowCount + row + rows) / columns.size());
+                if (progress->cancelRequested) {
+                    file.close();
+                    file.remove();
+                    setError(errorMessage, "Export cancelled.");
+                    return false;
+                }
+            }
+        }
+    }
+
+    if (!ok) {
+        setError(errorMessage, "Could not write binary workload: " + file.errorString());
+        file.close();
+        file.remove();
+        return false;
+    }
+    return true;
+}
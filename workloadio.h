@@ -0,0 +1,61 @@
+#ifndef WORKLOADIO_H
+#define WORKLOADIO_H
+
+#include <QString>
+
+#include <atomic>
+
+#include "csvparser.h"
+#include "schedulerengine.h"
+
+// Memory-maps fileName and parses its "ID,ArrivalTime,BurstTime,Priority" rows
+// into store (see parseWorkloadCsv). Returns false if the file cannot be read
+// or the import was cancelled; malformed rows are reported through result.
+bool loadWorkloadCsv(const QString &fileName, ProcessStore &store, QString *errorMessage = nullptr,
+                     CsvParseResult *result = nullptr, CsvParseProgress *progress = nullptr);
+
+// "Line 12: field BurstTime is not a valid integer" lines for a message box or log
+QString describeCsvErrors(const CsvParseResult &result, int maxLines = 10);
+
+// Lets another thread follow and cancel a results export
+struct ExportProgress
+{
+    std::atomic<int> rowsWritten{0};
+    std::atomic<bool> cancelRequested{false};
+};
+
+// Writes the per-process rows and summary block of the "Export Results" format
+// in a single pass through large buffered writes. Safe to call from a worker
+// thread as long as store is not modified meanwhile; a failed or cancelled
+// export removes the partial file.
+bool writeResultsCsv(const QString &fileName, const ProcessStore &store, SimTime currentTime,
+                     QString *errorMessage = nullptr, ExportProgress *progress = nullptr);
+
+// Versioned, column-oriented binary format for workloads and results
+// (little-endian, extension .simbin):
+//
+//   header     char magic[8] = "SCHEDSIM", uint32 version, uint32 columnCount,
+//              uint64 rowCount, int64 currentTime (0 for a plain workload)
+//   directory  columnCount x { char name[16], uint32 type, uint32 elementSize, uint64 offset }
+//   columns    rowCount packed elements each, starting at 64-byte aligned offsets
+//
+// Types are 1 = int32, 2 = int64, 3 = uint8. Workload files hold the id,
+// arrival, burst and priority columns; results files add start, completion
+// and status (0 Waiting, 1 Running, 2 Completed). Unknown columns are ignored
+// on load, so external tools can add their own.
+const char BinaryWorkloadMagic[8] = { 'S', 'C', 'H', 'E', 'D', 'S', 'I', 'M' };
+const quint32 BinaryWorkloadVersion = 1;
+
+bool isBinaryWorkloadFile(const QString &fileName);
+
+// Maps fileName and copies its input columns into store, one block copy per
+// column. Files with a burst time that is not positive are rejected.
+bool loadWorkloadBinary(const QString &fileName, ProcessStore &store, QString *errorMessage = nullptr);
+
+// Writes the input columns, plus the result columns when includeResults is
+// set. Like writeResultsCsv(), it reports progress in rows (spread over all
+// columns) and removes the partial file when it fails or is cancelled.
+bool writeWorkloadBinary(const QString &fileName, const ProcessStore &store, SimTime currentTime,
+                         bool includeResults, QString *errorMessage = nullptr, ExportProgress *progress = nullptr);
+
+#endif // WORKLOADIO_H